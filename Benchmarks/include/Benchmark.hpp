@@ -0,0 +1,63 @@
+//
+// Benchmark.hpp
+// Author: Antoine Bastide
+// Date: 16.10.2026
+//
+
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <cstddef>
+#include <string>
+
+#include "Engine/Types/Ptr.hpp"
+#include "Engine2D/Game2D.hpp"
+#include "Engine2D/SceneManagement/Scene.hpp"
+
+namespace Benchmarks {
+  /// Game used to step the benchmark scenes headless, nothing is rendered
+  class BenchmarkGame final : public Engine2D::Game2D {
+    public:
+      BenchmarkGame()
+        : Game2D(800, 600, "Benchmarks") {}
+  };
+
+  /// Average timings of a benchmark run
+  struct Result final {
+    /// The wall clock time of a tick, in milliseconds
+    double tickMilliseconds = 0.0;
+    /// The time spent in the fixed update of a tick, physics included, in milliseconds
+    double fixedUpdateMilliseconds = 0.0;
+  };
+
+  /**
+   * Creates a scene, makes it the active one and fills it with moving bodies without gravity, each with a box collider,
+   * spread evenly over a square centered on the origin
+   * @param name The name of the scene
+   * @param bodyCount The number of bodies to create
+   * @param spacing The distance between two neighbouring bodies, in world units
+   * @returns The created scene
+   * @note The bodies are placed with a fixed seed so that every run simulates the same world
+   */
+  Engine::Ptr<Engine2D::Scene> CreatePhysicsScene(const std::string &name, size_t bodyCount, float spacing = 3.0f);
+
+  /**
+   * Steps the active scene headless, then destroys it
+   * @param game The game used to step the scene
+   * @param ticks The number of ticks that are measured, after a few warm up ticks that add the entities to the scene
+   * @returns The average timings of the measured ticks
+   * @note The game must have been run headless once before the scene was created, the first run replaces the active
+   * scene with the default one
+   */
+  Result Run(BenchmarkGame &game, size_t ticks);
+
+  /// Steps the same physics scene with one to as many cores as the machine has and prints the time of a tick for each
+  /// number of cores
+  void ThreadingScaling(BenchmarkGame &game, size_t ticks);
+
+  /// Steps physics scenes of 1k, 10k and 100k bodies with each broad phase method and prints the time of their fixed
+  /// update for each of them
+  void BroadPhaseComparison(BenchmarkGame &game, size_t ticks);
+}
+
+#endif //BENCHMARK_HPP
@@ -0,0 +1,61 @@
+//
+// Benchmark.cpp
+// Author: Antoine Bastide
+// Date: 16.10.2026
+//
+
+#include <cmath>
+#include <random>
+
+#include "Benchmark.hpp"
+#include "Engine/Settings.hpp"
+#include "Engine2D/Entity2D.hpp"
+#include "Engine2D/Physics/Collider2D.hpp"
+#include "Engine2D/Physics/Rigidbody2D.hpp"
+#include "Engine2D/SceneManagement/SceneManager.hpp"
+
+/// The number of ticks run before measuring, the first one adds the entities to the scene
+#define WARMUP_TICKS 5
+
+namespace Benchmarks {
+  Engine::Ptr<Engine2D::Scene> CreatePhysicsScene(
+    const std::string &name, const size_t bodyCount, const float spacing
+  ) {
+    const auto scene = Engine2D::SceneManager::CreateScene(name);
+    Engine2D::SceneManager::SetActiveScene(name);
+    Engine::Settings::Physics::SetGravity(glm::vec2(0.0f));
+
+    std::mt19937 random(42);
+    std::uniform_real_distribution velocity(-2.0f, 2.0f);
+    const auto side = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(bodyCount))));
+    const float offset = static_cast<float>(side - 1) * spacing * 0.5f;
+    for (size_t i = 0; i < bodyCount; ++i) {
+      const glm::vec2 position(
+        static_cast<float>(i % side) * spacing - offset, static_cast<float>(i / side) * spacing - offset
+      );
+      const auto entity = Engine2D::Entity2D::Instantiate("Body", false, position);
+      const auto rigidbody = entity->AddComponent<Engine2D::Physics::Rigidbody2D>();
+      rigidbody->affectedByGravity = false;
+      rigidbody->linearVelocity = glm::vec2(velocity(random), velocity(random));
+      entity->AddComponent<Engine2D::Physics::BoxCollider2D>();
+    }
+    return scene;
+  }
+
+  Result Run(BenchmarkGame &game, const size_t ticks) {
+    const auto scene = Engine2D::SceneManager::ActiveScene();
+    const float fixedDeltaTime = Engine::Settings::Physics::FixedDeltaTime();
+    game.RunHeadless(WARMUP_TICKS, fixedDeltaTime);
+    const auto report = game.RunHeadless(ticks, fixedDeltaTime);
+    Engine2D::SceneManager::DestroyScene(scene->Name());
+
+    Result result;
+    if (report.ticks == 0)
+      return result;
+    result.tickMilliseconds = report.seconds * 1000.0 / static_cast<double>(report.ticks);
+    for (const auto &system: report.systems)
+      if (system.name == "FixedUpdate")
+        result.fixedUpdateMilliseconds = system.seconds * 1000.0 / static_cast<double>(report.ticks);
+    return result;
+  }
+}
@@ -0,0 +1,46 @@
+//
+// BroadPhaseBenchmark.cpp
+// Author: Antoine Bastide
+// Date: 16.10.2026
+//
+
+#include <array>
+#include <iomanip>
+#include <iostream>
+#include <ranges>
+#include <utility>
+
+#include "Benchmark.hpp"
+#include "Engine/Settings.hpp"
+
+namespace Benchmarks {
+  void BroadPhaseComparison(BenchmarkGame &game, const size_t ticks) {
+    using BroadPhase = Engine::Settings::Physics::BroadPhase;
+
+    constexpr std::array<size_t, 3> bodyCounts = {1000, 10000, 100000};
+    constexpr std::array<std::pair<BroadPhase, const char *>, 3> methods = {
+      std::pair{BroadPhase::SortAndSweep, "SortAndSweep"}, std::pair{BroadPhase::Grid, "Grid"},
+      std::pair{BroadPhase::Tree, "Tree"}
+    };
+
+    std::cout << "Broad phase comparison, " << ticks << " ticks\n";
+    std::cout << std::setw(10) << "bodies";
+    for (const auto &name: methods | std::views::values)
+      std::cout << std::setw(16) << name;
+    std::cout << "   (fixed update ms/tick)\n";
+
+    for (const size_t bodyCount: bodyCounts) {
+      std::cout << std::setw(10) << bodyCount;
+      for (const auto &method: methods | std::views::keys) {
+        // The physics settings are per scene, so the method is set once the scene is the active one
+        CreatePhysicsScene("BroadPhase", bodyCount);
+        Engine::Settings::Physics::SetBroadPhaseMethod(method);
+        const Result result = Run(game, ticks);
+        std::cout << std::fixed << std::setprecision(3) << std::setw(16) << result.fixedUpdateMilliseconds
+          << std::flush;
+      }
+      std::cout << '\n';
+    }
+    std::cout << std::endl;
+  }
+}
@@ -0,0 +1,48 @@
+//
+// ThreadingBenchmark.cpp
+// Author: Antoine Bastide
+// Date: 16.10.2026
+//
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include "Benchmark.hpp"
+#include "Engine/Settings.hpp"
+#include "Engine/Threading/JobSystem.hpp"
+
+/// The number of bodies of the scene stepped with each number of cores
+#define THREADING_BODY_COUNT 10000
+
+namespace Benchmarks {
+  void ThreadingScaling(BenchmarkGame &game, const size_t ticks) {
+    using Threading = Engine::Settings::Threading;
+
+    const size_t maxCores = std::max(std::thread::hardware_concurrency(), 1u);
+    std::cout << "Threading scaling, " << THREADING_BODY_COUNT << " bodies, " << ticks << " ticks\n";
+    std::cout << std::setw(8) << "cores" << std::setw(14) << "ms/tick" << std::setw(18) << "fixed ms/tick"
+      << std::setw(10) << "speedup" << '\n';
+
+    double baseline = 0.0;
+    for (size_t cores = 1; cores <= maxCores; ++cores) {
+      // The calling thread steps the scene, the other cores are given to the workers
+      const size_t workers = cores - 1;
+      Threading::SetThreadingModel(workers == 0 ? Threading::Model::SingleThread : Threading::Model::WorkerPool);
+      Threading::SetWorkerCount(static_cast<uint>(workers));
+      // The threading settings are only read when the game starts, the job system is restarted with them instead
+      Engine::Threading::JobSystem::Initialize(workers);
+
+      CreatePhysicsScene("Threading", THREADING_BODY_COUNT);
+      const Result result = Run(game, ticks);
+      if (cores == 1)
+        baseline = result.tickMilliseconds;
+
+      std::cout << std::fixed << std::setprecision(3) << std::setw(8) << cores << std::setw(14)
+        << result.tickMilliseconds << std::setw(18) << result.fixedUpdateMilliseconds << std::setw(10)
+        << (result.tickMilliseconds > 0.0 ? baseline / result.tickMilliseconds : 0.0) << '\n';
+    }
+    std::cout << std::endl;
+  }
+}
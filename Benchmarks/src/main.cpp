@@ -0,0 +1,39 @@
+//
+// main.cpp
+// Author: Antoine Bastide
+// Date: 16.10.2026
+//
+
+#include <iostream>
+#include <string>
+
+#include "Benchmark.hpp"
+#include "Engine/Settings.hpp"
+
+/// Usage: EngineBenchmarks [suite] [ticks]
+/// suite: all (default), threading or broadphase
+/// ticks: the number of measured ticks of each run, 120 by default
+int main(const int argc, char **argv) {
+  const std::string suite = argc > 1 ? argv[1] : "all";
+  const size_t ticks = argc > 2 ? std::stoul(argv[2]) : 120;
+
+  Benchmarks::BenchmarkGame game;
+  // Sets the game up headless, its default scene is replaced by the scene of each benchmark
+  game.RunHeadless(0, Engine::Settings::Physics::FixedDeltaTime());
+
+  bool ran = false;
+  if (suite == "all" || suite == "threading") {
+    Benchmarks::ThreadingScaling(game, ticks);
+    ran = true;
+  }
+  if (suite == "all" || suite == "broadphase") {
+    Benchmarks::BroadPhaseComparison(game, ticks);
+    ran = true;
+  }
+
+  if (!ran) {
+    std::cerr << "Unknown benchmark suite: " << suite << std::endl;
+    return 1;
+  }
+  return 0;
+}
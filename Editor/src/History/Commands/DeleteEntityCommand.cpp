@@ -28,6 +28,7 @@ namespace Editor::History {
 
         it->get()->forceSetParent(nullptr);
         it->get()->SetActive(false);
+        scene->unindexEntity(it->get());
         if (!multipleEntitiesDeleted)
           multipleEntitiesDeleted = !it->get()->Transform()->Children().empty();
 
@@ -48,6 +49,7 @@ namespace Editor::History {
       it->entity->SetActive(it->wasActive);
       if (it->parent)
         it->parent->Transform()->MakeNthChild(it->entity.get(), it->childIndex);
+      scene->indexEntity(it->entity.get());
 
       scene->entities.insert(scene->entities.begin() + it->index, std::move(it->entity));
     }
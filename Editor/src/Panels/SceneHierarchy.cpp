@@ -84,6 +84,7 @@ namespace Editor {
         if (ImGui::MenuItem("Discard Changes", "", false, std::filesystem::exists(path) && contextChanged)) {
           auto &scene = Engine2D::SceneManager::getSceneRef(context->name);
           scene = Engine::Reflection::Deserializer::FromJsonFromFile<std::unique_ptr<Engine2D::Scene>>(path);
+          scene->bindInput();
 
           SetContext(scene.get());
           Engine2D::SceneManager::activeScene = scene.get();
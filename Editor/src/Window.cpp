@@ -45,11 +45,8 @@ namespace Editor {
           game->processInput();
 
         if (const auto scene = Engine2D::SceneManager::ActiveScene(); scene) {
-          #if MULTI_THREAD
-          if (std::ranges::find(scene->entitiesToDestroy, EntityInspector::context) != scene->entitiesToDestroy.end())
-          #else
-          if (std::ranges::find(scene->entitiesToRemove, EntityInspector::context) != scene->entitiesToRemove.end())
-          #endif
+          if (scene->entitiesToDestroy.contains(EntityInspector::context) ||
+              scene->entitiesToRemove.contains(EntityInspector::context))
             EntityInspector::SetContext(nullptr);
           game->updateGame();
         }
@@ -190,7 +190,6 @@ function(setup_engine_target TARGET_NAME)
     target_compile_definitions(${TARGET_NAME} PUBLIC
         $<$<CONFIG:Debug>:GAME_DEBUG=1>
         $<$<BOOL:${PROFILE}>:ENGINE_PROFILING=1>
-        MULTI_THREAD=1
         ENGINE_EDITOR=$<BOOL:$<STREQUAL:${PROJECT_BUILD_TYPE},shared>>
     )
 endfunction()
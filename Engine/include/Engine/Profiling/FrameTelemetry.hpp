@@ -0,0 +1,141 @@
+//
+// FrameTelemetry.hpp
+// Author: Antoine Bastide
+// Date: 16.10.2026
+//
+
+#ifndef FRAME_TELEMETRY_HPP
+#define FRAME_TELEMETRY_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Engine2D {
+  class Scene;
+  class Game2D;
+}
+
+namespace Engine::Profiling {
+  /**
+   * Keeps the time spent in each stage of the last frames in a ring buffer so that the game can query frame time
+   * statistics at runtime or export them to a file. Unlike the Instrumentor, it is always enabled and does not need a
+   * profiling build.
+   * Only the frames of the game are recorded, the scenes stepped through SceneManager::ScopedScene are not timed.
+   */
+  class FrameTelemetry final {
+    friend class Engine2D::Scene;
+    friend class Engine2D::Game2D;
+    public:
+      /// The stages of a frame that are timed
+      enum Stage : uint8_t {
+        /// Polling the window events and processing the input devices
+        Input,
+        /// Adding and removing the pending entities
+        Sync,
+        /// Calling OnUpdate on the behaviours
+        Update,
+        /// Calling OnFixedUpdate on the behaviours
+        FixedUpdate,
+        /// Stepping the physics simulation
+        Physics,
+        /// Updating the animators
+        Animate,
+        /// Extracting the render data of the scene
+        Extract,
+        /// Sending the render data to the GPU and presenting it
+        Submit,
+        /// The whole frame, including the time spent waiting for the target frame rate
+        Frame,
+        /// The number of stages
+        Count
+      };
+
+      /// Timing statistics of a stage over the recorded frames, in milliseconds
+      struct Statistics final {
+        /// The shortest recorded time
+        float min = 0.0f;
+        /// The mean of the recorded times
+        float average = 0.0f;
+        /// The longest recorded time
+        float max = 0.0f;
+        /// 95% of the recorded times are shorter than this one
+        float p95 = 0.0f;
+        /// 99% of the recorded times are shorter than this one
+        float p99 = 0.0f;
+      };
+
+      /// Sets the number of frames kept in memory, clears the recorded frames
+      static void SetCapacity(size_t capacity);
+      /// @returns The number of frames kept in memory
+      [[nodiscard]] static size_t Capacity();
+      /// @returns The number of frames currently recorded
+      [[nodiscard]] static size_t FrameCount();
+      /// @returns The timing statistics of the given stage over the recorded frames
+      [[nodiscard]] static Statistics Query(Stage stage);
+      /// @returns The time spent in the given stage during the last completed frame, in milliseconds
+      [[nodiscard]] static float Last(Stage stage);
+      /// @returns The average number of frames per second over the recorded frames
+      [[nodiscard]] static float FramesPerSecond();
+      /// @returns The name of the given stage
+      [[nodiscard]] static const char *StageName(Stage stage);
+      /**
+       * Writes all the recorded frames to the given file as CSV, from the oldest to the newest, one column per stage
+       * @param path The path of the file to write
+       * @returns True if the file could be written, false if not
+       */
+      static bool Export(const std::string &path);
+      /// Removes all the recorded frames
+      static void Clear();
+    private:
+      using Timings = std::array<float, Count>;
+
+      /// Adds the time elapsed since its creation to a stage of a frame when destroyed
+      class ScopedStage final {
+        public:
+          /// Times the given stage of the frame in progress
+          explicit ScopedStage(Stage stage);
+          /// Times the given stage of the given frame, used by the render thread to add to the frame it draws
+          ScopedStage(Stage stage, uint64_t frame);
+          ~ScopedStage();
+        private:
+          /// The stage being timed
+          Stage stage;
+          /// The index of the frame the stage belongs to
+          uint64_t frame;
+          /// Whether the stage is recorded, false when it is run by a scene stepped through a ScopedScene
+          bool recorded;
+          /// The time at which the stage started
+          std::chrono::steady_clock::time_point start;
+      };
+
+      /// The recorded frames, used as a ring buffer
+      inline static std::vector<Timings> frames;
+      /// The index at which the next frame will be written
+      inline static size_t head = 0;
+      /// The number of valid frames in the buffer
+      inline static size_t count = 0;
+      /// The number of frames kept in memory
+      inline static size_t capacity = 600;
+      /// The stage timings of the frame in progress
+      inline static Timings current{};
+      /// The index of the frame in progress, atomic since the stages read it when they start
+      inline static std::atomic<uint64_t> frameIndex = 0;
+      /// Guards the data, the submit stage is recorded by the render thread
+      inline static std::mutex mutex;
+
+      FrameTelemetry() = default;
+
+      /// Adds the given time to a stage of the given frame, the frame is either in progress or one of the recorded ones
+      static void record(Stage stage, float milliseconds, uint64_t frame);
+      /// Stores the current frame in the buffer and starts a new one
+      /// @param milliseconds The duration of the whole frame
+      static void endFrame(float milliseconds);
+  };
+}
+
+#endif //FRAME_TELEMETRY_HPP
@@ -10,6 +10,7 @@
 #include <functional>
 #include <memory>
 #include <stdexcept>
+#include <type_traits>
 #include <typeinfo>
 #include <unordered_map>
 
@@ -27,7 +28,17 @@ namespace Engine::Reflection {
       template<typename T> static void RegisterType(const std::string &type) {
         engineNameToTypeIdName[type] = typeid(T).name();
         typeIdNameToFactory[typeid(T).name()] = [] {
-          return static_cast<void *>(new T());
+          T *instance = new T();
+          // Let the type finish its setup now that its concrete type is known
+          if constexpr (requires { T::template _e_onCreate<T>(instance); })
+            T::template _e_onCreate<T>(instance);
+          return static_cast<void *>(instance);
+        };
+        typeIdNameToCloner[typeid(T).name()] = [](const void *instance) -> void * {
+          if constexpr (std::is_copy_constructible_v<T>)
+            return new T(*static_cast<const T *>(instance));
+          else
+            return nullptr;
         };
       }
 
@@ -61,6 +72,15 @@ namespace Engine::Reflection {
         return std::unique_ptr<T>(typedPtr);
       }
 
+      /// @returns A copy of the given instance made by the copy constructor of its dynamic type, nullptr if that type is
+      /// not registered or can not be copied
+      template<typename T> requires std::is_polymorphic_v<T> static std::unique_ptr<T> Clone(const T &instance) {
+        const auto it = typeIdNameToCloner.find(typeid(instance).name());
+        if (it == typeIdNameToCloner.end())
+          return nullptr;
+        return std::unique_ptr<T>(static_cast<T *>(it->second(dynamic_cast<const void *>(&instance))));
+      }
+
       /// Registers an enum for reflection
       /// @tparam T The enum to register
       /// @param enumName The name of the enum to register
@@ -145,6 +165,7 @@ namespace Engine::Reflection {
     private:
       inline static std::unordered_map<std::string, std::string> engineNameToTypeIdName;
       inline static std::unordered_map<std::string, std::function<void*()>> typeIdNameToFactory;
+      inline static std::unordered_map<std::string, void *(*)(const void *)> typeIdNameToCloner;
 
       inline static std::unordered_map<std::string, std::string> enumTypeIdToName;
       inline static std::unordered_map<std::string, std::vector<std::string>> enumValues;
@@ -154,6 +175,7 @@ namespace Engine::Reflection {
 
       static void cleanup() {
         typeIdNameToFactory.clear();
+        typeIdNameToCloner.clear();
         engineNameToTypeIdName.clear();
         enumTypeIdToName.clear();
         enumValues.clear();
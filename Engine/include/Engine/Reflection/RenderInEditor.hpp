@@ -845,9 +845,9 @@ namespace Engine::Reflection {
 
     std::string entityName = "";
     if constexpr (std::is_same_v<std::remove_cvref_t<ElementType>, Engine2D::Entity2D>)
-      entityName = !data ? "None" : data->name;
+      entityName = !data ? "None" : data->Name();
     else if constexpr (HasEntityMethod<std::remove_cvref_t<ElementType>>)
-      entityName = !data ? "None" : data->Entity()->name;
+      entityName = !data ? "None" : data->Entity()->Name();
     else
       return false;
 
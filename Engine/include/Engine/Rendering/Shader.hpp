@@ -7,6 +7,8 @@
 #ifndef SHADER_H
 #define SHADER_H
 
+#include <atomic>
+
 #include "Engine/Reflection/Reflectable.hpp"
 
 namespace Engine {
@@ -110,8 +112,8 @@ namespace Engine::Rendering {
        */
       void SetMatrix4(const char *name, const glm::mat4 &matrix, bool useShader = false);
     private:
-      /// Used to reference and manage this shader program within OpenGL.
-      uint id;
+      /// Used to reference and manage this shader program within OpenGL, 0 until it has been linked by the render thread
+      std::atomic<uint> id{0};
       /// The name of this shader
       std::string name;
       /// The path of the file this shader is stored in
@@ -7,6 +7,7 @@
 #ifndef TEXTURE_H
 #define TEXTURE_H
 
+#include <atomic>
 #include <string>
 
 namespace Engine {
@@ -50,8 +51,8 @@ namespace Engine::Rendering {
       /// @returns Whether this texture is transparent or not
       bool Transparent() const;
     private:
-      /// The OpenGL id of this texture
-      unsigned int id;
+      /// The OpenGL id of this texture, 0 until the texture has been uploaded by the render thread
+      std::atomic<unsigned int> id;
       /// The width of this texture in pixels.
       int width;
       /// The height of this texture in pixels.
@@ -64,19 +65,13 @@ namespace Engine::Rendering {
       bool transparent;
 
       /**
-       * Sets up the texture with specified width, height, and pixel data.
-       * @param width The width of the texture in pixels.
-       * @param height The height of the texture in pixels.
+       * Uploads the given pixel data to the GPU, the width and height of the texture must be set beforehand.
        * @param data The pixel data for the texture, typically loaded from an image file.
        * @param internalFormat
        * @param dataFormat
-       * @param transparent
        * @param blended Whether to blend the pixels or not
        */
-      void generate(
-        int width, int height, const unsigned char *data, int internalFormat, int dataFormat, bool transparent,
-        bool blended = false
-      );
+      void generate(const unsigned char *data, int internalFormat, int dataFormat, bool blended = false);
       /// Makes this texture active so that subsequent rendering operations use it.
       void bind(int offset = 0) const;
       /// Unloads the texture data and prepares the object for reuse.
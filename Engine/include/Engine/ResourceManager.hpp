@@ -8,6 +8,7 @@
 #define RESOURCEMANAGER_H
 
 #include <map>
+#include <mutex>
 #include <glm/glm.hpp>
 
 #include "Engine/Rendering/Shader.hpp"
@@ -130,6 +131,8 @@ namespace Engine {
       inline static std::map<std::string, std::unique_ptr<Texture>> textures;
       /// The sprites that have been loaded to memory by the Resource Manager
       inline static std::map<std::string, std::unique_ptr<Sprite>> sprites;
+      /// Guards the shaders, textures and sprites, scenes can be loaded on a background thread while the game uses them
+      inline static std::recursive_mutex mutex;
       /// The default value for a rect (the whole image)
       inline static glm::vec4 defaultRect{0, 0, 1, 1};
 
@@ -8,8 +8,13 @@
 #define SETTINGS_H
 
 #include <string>
+#include <vector>
 #include <glm/glm.hpp>
 
+namespace Engine2D {
+  class Scene;
+}
+
 namespace Engine {
   /// Static class containing all the settings related to the engine
   class Settings {
@@ -50,6 +55,20 @@ namespace Engine {
           /// Changes the frame rate will target, if set to 0, the game will not cap the frame rate.<br>
           /// Warning: Uncapping the frame rate may cause the game to utilize maximum CPU resources in an attempt to achieve the highest possible frame rate.
           static void SetTargetFrameRate(unsigned int newValue);
+          /// If true, the game goes idle while its window is unfocused or minimized
+          static void SetIdleWhenUnfocused(bool newState);
+          /// Changes how long the game can go without any keyboard or mouse input before going idle, in seconds.
+          /// If set to 0, the game never goes idle because of a lack of input.
+          static void SetIdleTimeout(float newValue);
+          /// Changes the frame rate of the game while it is idle, at least 1. While idle, the game sleeps until the next
+          /// frame or until an event wakes it up instead of spin-waiting, and resumes its full frame rate as soon as it
+          /// is focused or receives input.
+          static void SetIdleFrameRate(unsigned int newValue);
+          /// Changes how long the render thread can spend running queued commands, such as resource uploads, before
+          /// drawing the next frame, in milliseconds, defaulted to 2. The remaining commands are run before the
+          /// following frames, so loading many resources does not freeze the game. If set to 0, every queued command is
+          /// run before the next frame.
+          static void SetRenderCommandBudget(float newValue);
 
           /// @returns True if the rendering will sync to the refresh rate of the monitor it is running on, false if not.
           [[nodiscard]] static bool VsyncEnabled();
@@ -57,23 +76,68 @@ namespace Engine {
           [[nodiscard]] static bool MaintainAspectRatio();
           /// @returns How many frames wil be rendered per second, if 0 the engine will render as many as possible
           [[nodiscard]] static unsigned int TargetFrameRate();
+          /// @returns True if the game goes idle while its window is unfocused or minimized, false if not
+          [[nodiscard]] static bool IdleWhenUnfocused();
+          /// @returns How long the game can go without input before going idle in seconds, 0 if it never does
+          [[nodiscard]] static float IdleTimeout();
+          /// @returns How many frames are run per second while the game is idle
+          [[nodiscard]] static unsigned int IdleFrameRate();
+          /// @returns How long queued commands can run before a frame is drawn in milliseconds, 0 if there is no limit
+          [[nodiscard]] static float RenderCommandBudget();
         private:
           inline static bool vsyncEnabled = false;
           inline static bool maintainAspectRatio = true;
           inline static unsigned int targetFrameRate = 0;
+          inline static bool idleWhenUnfocused = true;
+          inline static float idleTimeout = 0.0f;
+          inline static unsigned int idleFrameRate = 10;
+          inline static float renderCommandBudget = 2.0f;
 
           Graphics() = default;
       };
 
-      /// Static class containing all the settings related to the physics engine
+      /// Static class containing all the settings related to the physics.
+      /// Each scene has its own physics settings, new scenes start with the values set on the main thread. The setters
+      /// and getters apply to the active scene of the calling thread, see SceneManager::ScopedScene.
       class Physics final {
         friend class Settings;
+        friend class Engine2D::Scene;
         public:
-          /// Changes the rate at which the physics simulations are run, clamped between 0.02f and 0.016...7f (50 or 60 times a second).
+          enum class BroadPhase {
+            SortAndSweep = 0, Grid, Tree
+          };
+
+          /// The physics settings of a scene
+          struct Values final {
+            float fixedDeltaTime = 1.0f / 60.0f;
+            uint maxSubsteps = 8;
+            bool interpolation = true;
+            BroadPhase broadPhase = BroadPhase::SortAndSweep;
+            glm::vec<2, size_t> partitionSize = glm::vec<2, size_t>(4, 4);
+            glm::vec2 gravity = glm::vec2(0.0f, -9.81f);
+          };
+
+          /// Changes the rate at which the physics simulations are run, clamped between 0.0083...3f and 0.05f (120 to 20 times a
+          /// second). Lower rates are smoothed out when rendering if interpolation is enabled.
           static void SetFixedDeltaTime(float newValue);
+          /// Changes the maximum number of physics steps that can be run during a single frame, at least 1, defaulted to 8.
+          /// If a frame takes too long, the time that does not fit in this budget is dropped instead of making the next
+          /// frame run even more steps.
+          static void SetMaxSubsteps(uint newValue);
+          /// If true, the position and rotation of the entities moved by the physics engine are rendered interpolated
+          /// between the last two physics steps, which removes the stutter caused by the physics and render rates differing.
+          static void SetInterpolation(bool newState);
           /// Changes if the physics engine should use spacial partitioning to resolve collisions or not.
           /// It does not always lead to a performance boost, consider using it if you have a lot of dynamic colliders on screen.
+          /// Same as setting the broad phase method to Grid if true, or to SortAndSweep if false.
           static void SetUseScreenPartitioning(bool newState);
+          /// Set how the physics engine finds the colliders whose bounds overlap, defaulted to SortAndSweep:
+          /// - SortAndSweep: the colliders are sorted along the x axis and compared with the ones they overlap on it
+          /// - Grid: sort and sweep within each cell of a grid that covers the viewport, colliders outside of it are
+          ///   placed in the cells on its edges
+          /// - Tree: the colliders are kept in a dynamic AABB tree that is not bound to the viewport, best for large
+          ///   worlds or when most colliders move little between steps
+          static void SetBroadPhaseMethod(BroadPhase newValue);
           /// Changes the size of the partitioning of the screen for the physics simulation, defaulted to 4x4.
           /// Increasing the value does not always lead to a performance boost.
           /// It is better to test different values to find the best size for your game.
@@ -83,19 +147,30 @@ namespace Engine {
 
           /// @returns The rate at which the physics simulations are run
           [[nodiscard]] static float FixedDeltaTime();
+          /// @returns The maximum number of physics steps that can be run during a single frame
+          [[nodiscard]] static uint MaxSubsteps();
+          /// @returns True if the rendered transforms of physics bodies are interpolated between physics steps, false if not
+          [[nodiscard]] static bool Interpolation();
           /// @returns True if the physics engine is currently using screen partitioning, false if not
           [[nodiscard]] static bool UseScreenPartitioning();
+          /// @returns How the physics engine finds the colliders whose bounds overlap
+          [[nodiscard]] static BroadPhase BroadPhaseMethod();
           /// @return The size of the screen partitioning used by the physics engine
           [[nodiscard]] static glm::vec<2, size_t> PartitionSize();
           /// @returns The value of gravity used by the physics engine
           [[nodiscard]] static glm::vec2 Gravity();
         private:
-          inline static float fixedDeltaTime = 1.0f / 60.0f;
-          inline static bool useScreenPartitioning = false;
-          inline static auto partitionSize = glm::vec<2, size_t>(4, 4);
-          inline static auto gravity = glm::vec2(0.0f, -9.81f);
+          /// The settings new scenes start with
+          inline static Values defaults;
 
           Physics() = default;
+
+          /// @returns The settings of the active scene of the calling thread, the defaults if there is none
+          static Values &current();
+          template<typename T>
+          /// Changes the given setting of the active scene of the calling thread, and of the new scenes unless the
+          /// calling thread steps a scene of its own
+          static void set(T Values::*setting, T value);
       };
 
       /// Static class containing all the settings related to the input system
@@ -133,6 +208,41 @@ namespace Engine {
           Input() = default;
       };
 
+      /// Static class containing all the settings related to threading, they are applied when the game starts running
+      class Threading final {
+        friend class Settings;
+        public:
+          enum class Model {
+            SingleThread = 0, RenderThread, WorkerPool
+          };
+
+          /// Set which threads the engine uses:
+          /// - SingleThread: the game is updated and rendered on the main thread, jobs are executed inline
+          /// - RenderThread: the game is rendered on its own thread while the next frame is updated, jobs are executed inline
+          /// - WorkerPool: the game is rendered on its own thread and jobs are executed by a pool of worker threads
+          static void SetThreadingModel(Model newValue);
+          /// Changes the number of worker threads used by the WorkerPool model, if 0 one is started per core that is not
+          /// used by the update and render threads
+          static void SetWorkerCount(uint newValue);
+          /// Changes the cores the engine threads are pinned to: the update thread to the first one, the render thread to the
+          /// second one and the workers to the next ones, wrapping around. If empty, the threads are not pinned.
+          /// Pinning is not supported on macOS.
+          static void SetAffinity(const std::vector<uint> &newValue);
+
+          /// @returns The threading model used by the engine
+          [[nodiscard]] static Model ThreadingModel();
+          /// @returns The number of worker threads used by the WorkerPool model, 0 if it is based on the number of cores
+          [[nodiscard]] static uint WorkerCount();
+          /// @returns The cores the engine threads are pinned to
+          [[nodiscard]] static const std::vector<uint> &Affinity();
+        private:
+          inline static auto threadingModel = Model::WorkerPool;
+          inline static uint workerCount = 0;
+          inline static std::vector<uint> affinity;
+
+          Threading() = default;
+      };
+
       class Profiling final {
         public:
           enum class Level {
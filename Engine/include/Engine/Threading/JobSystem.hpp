@@ -0,0 +1,191 @@
+//
+// JobSystem.hpp
+// Author: Antoine Bastide
+// Date: 16.10.2026
+//
+
+#ifndef JOB_SYSTEM_HPP
+#define JOB_SYSTEM_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Engine::Threading {
+  class TaskGraph;
+
+  /// A unit of work that can be executed by the job system
+  using Job = std::function<void()>;
+  /// A unit of work that processes the indices in the range [begin, end)
+  using RangeJob = std::function<void(size_t begin, size_t end)>;
+
+  /// Tracks the completion of a group of jobs, a counter can be waited on using JobSystem::Wait
+  class JobCounter final {
+    friend class JobSystem;
+    friend class TaskGraph;
+    public:
+      JobCounter() = default;
+      JobCounter(const JobCounter &) = delete;
+      JobCounter &operator=(const JobCounter &) = delete;
+
+      /// @returns True if all the jobs linked to this counter have finished executing
+      [[nodiscard]] bool IsDone() const;
+    private:
+      /// The number of jobs that have not finished executing
+      std::atomic<size_t> pending{0};
+  };
+
+  /**
+   * Work-stealing job scheduler shared by all the engine systems.
+   * Each worker owns a queue, it pops the most recently pushed job from it and steals the oldest job from the other
+   * queues when its own is empty. Threads that wait on a counter help executing jobs instead of blocking, which makes
+   * it safe to schedule and wait on jobs from within other jobs.
+   * Each thread has a context that the jobs it schedules inherit, whichever thread ends up executing them, the engine
+   * uses it to know which scene a job is stepping when multiple scenes are stepped in parallel.
+   * @note When the job system has no workers, all the jobs are executed inline on the calling thread.
+   */
+  class JobSystem final {
+    friend class TaskGraph;
+    public:
+      /**
+       * Starts the worker threads
+       * @param workerCount The number of worker threads to start, if 0 all the jobs are executed inline
+       * @param cores The cores the workers are pinned to, in order and wrapping around, if empty the workers are not
+       * pinned
+       * @note Calling this method while the job system is running restarts it with the new worker count, it must not be
+       * called while jobs are being scheduled
+       */
+      static void Initialize(size_t workerCount, const std::vector<uint> &cores = {});
+      /// Waits for all the queued jobs to finish and stops the worker threads
+      static void Shutdown();
+
+      /// @returns The number of worker threads, excluding the threads that submit jobs
+      [[nodiscard]] static size_t WorkerCount();
+      /// @returns True if the worker threads are running, false if jobs are executed inline
+      [[nodiscard]] static bool IsRunning();
+      /// @returns The number of workers that leaves a core to each of the given number of engine threads
+      [[nodiscard]] static size_t DefaultWorkerCount(size_t reservedThreads);
+      /// Pins the calling thread to the given core
+      /// @returns True if the thread was pinned, false if the platform does not support it or the core does not exist
+      static bool PinCurrentThread(uint core);
+
+      /**
+       * Schedules the given job to be executed by a worker thread
+       * @param job The job to execute
+       * @param counter The counter to increment until the job has finished executing, can be null
+       */
+      static void Schedule(Job job, JobCounter *counter = nullptr);
+      /// Blocks until all the jobs linked to the given counter have finished, executing pending jobs while waiting
+      static void Wait(const JobCounter &counter);
+
+      /**
+       * Splits the range [0, count) in chunks of at least grainSize elements and processes them in parallel
+       * @param count The number of elements to process
+       * @param grainSize The minimum number of elements processed by a single job
+       * @param job The job called for each chunk of the range
+       * @note This call blocks until the whole range has been processed, the calling thread processes the first chunk
+       */
+      static void ParallelFor(size_t count, size_t grainSize, const RangeJob &job);
+
+      /// Sets the context of the calling thread, the jobs it schedules from now on are executed with the same context
+      static void SetContext(void *context);
+      /// @returns The context of the calling thread, or of the job it is executing, null if none was set
+      [[nodiscard]] static void *Context();
+    private:
+      /// A job and the counter to decrement once it has finished
+      struct QueuedJob final {
+        Job job;
+        JobCounter *counter;
+        /// The context of the thread that scheduled the job
+        void *context;
+      };
+
+      /// Queue of jobs owned by a single thread, the other threads steal from the front of it
+      struct WorkQueue final {
+        std::mutex mutex;
+        std::deque<QueuedJob> jobs;
+      };
+
+      /// The queues of all the threads, index 0 is shared by all the threads that are not workers
+      inline static std::vector<std::unique_ptr<WorkQueue>> queues;
+      /// The worker threads
+      inline static std::vector<std::thread> workers;
+      /// Whether the worker threads should keep running
+      inline static std::atomic<bool> running = false;
+      /// The number of jobs waiting in the queues
+      inline static std::atomic<size_t> queuedJobs = 0;
+      /// Mutex used to put the idle workers to sleep
+      inline static std::mutex sleepMutex;
+      /// Wakes up the idle workers when new jobs are scheduled
+      inline static std::condition_variable sleepCV;
+      /// The index of the queue owned by the current thread
+      inline static thread_local size_t queueIndex = 0;
+      /// The context of the current thread, replaced by the context of the job it is executing
+      inline static thread_local void *context = nullptr;
+
+      JobSystem() = default;
+
+      /// The loop run by each worker thread
+      static void workerLoop(size_t index);
+      /// Pops a job from the given queue or steals one from another queue and executes it
+      /// @returns True if a job was executed, false if all the queues were empty
+      static bool executeNext(size_t index);
+      /// Executes the given job and signals its counter
+      static void execute(QueuedJob &queuedJob);
+  };
+
+  /**
+   * Set of jobs with dependencies between them, a task only starts once all the tasks that precede it have finished.
+   * The graph can be run multiple times, which allows systems to build it once and reuse it every frame.
+   */
+  class TaskGraph final {
+    public:
+      using TaskId = size_t;
+
+      TaskGraph() = default;
+      TaskGraph(const TaskGraph &) = delete;
+      TaskGraph &operator=(const TaskGraph &) = delete;
+
+      /// Adds a task to the graph
+      /// @returns The id of the new task
+      TaskId Add(Job job);
+      /// Makes the task after wait for the task before to finish before starting
+      void Precede(TaskId before, TaskId after);
+      /// Runs all the tasks of the graph and blocks until they have all finished
+      void Run();
+      /// Removes all the tasks from the graph
+      void Clear();
+
+      /// @returns The number of tasks in the graph
+      [[nodiscard]] size_t Size() const;
+    private:
+      struct Task final {
+        Job job;
+        /// The tasks waiting on this task
+        std::vector<TaskId> successors;
+        /// The number of tasks that precede this task
+        size_t dependencyCount = 0;
+        /// The number of preceding tasks that have not finished during the current run
+        std::atomic<size_t> remainingDependencies = 0;
+      };
+
+      /// All the tasks of the graph, stored as pointers since atomics cannot be moved
+      std::vector<std::unique_ptr<Task>> tasks;
+      /// Tracks the completion of the current run
+      JobCounter counter;
+      /// Whether the graph has been checked for cycles since the last change
+      bool validated = false;
+
+      /// Schedules the given task, its successors are scheduled once it has finished
+      void schedule(TaskId id);
+      /// @returns True if the graph does not contain any cycle
+      [[nodiscard]] bool isAcyclic() const;
+  };
+}
+
+#endif //JOB_SYSTEM_HPP
@@ -0,0 +1,71 @@
+//
+// RenderCommandQueue.hpp
+// Author: Antoine Bastide
+// Date: 16.10.2026
+//
+
+#ifndef RENDER_COMMAND_QUEUE_HPP
+#define RENDER_COMMAND_QUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+
+namespace Engine::Threading {
+  /// A command that has to be executed on the thread that owns the OpenGL context
+  using RenderCommand = std::function<void()>;
+
+  /**
+   * Lock-free multiple producers, single consumer queue of render commands.
+   * Any thread can push commands, only the render thread drains them, in the order they were pushed by each producer.
+   */
+  class RenderCommandQueue final {
+    public:
+      RenderCommandQueue();
+      ~RenderCommandQueue();
+      RenderCommandQueue(const RenderCommandQueue &) = delete;
+      RenderCommandQueue &operator=(const RenderCommandQueue &) = delete;
+
+      /// Adds the given command to the queue, can be called from any thread
+      void Push(RenderCommand command);
+
+      template<typename F, typename R = std::invoke_result_t<F>>
+      /// Adds the given command to the queue, can be called from any thread
+      /// @returns A future that holds the result of the command once it has been executed
+      std::future<R> Submit(F &&command) {
+        auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(command));
+        std::future<R> future = task->get_future();
+        Push(
+          [task] {
+            (*task)();
+          }
+        );
+        return future;
+      }
+
+      /// Executes all the commands in the queue, must only be called by the consumer thread
+      /// @returns The number of commands executed
+      size_t Drain();
+      /// Executes the commands in the queue until the given time has elapsed, at least one command is executed and the
+      /// remaining ones are left for the next call, must only be called by the consumer thread
+      /// @returns The number of commands executed
+      size_t Drain(std::chrono::steady_clock::duration budget);
+      /// @returns True if no command is waiting in the queue, must only be called by the consumer thread
+      [[nodiscard]] bool Empty() const;
+    private:
+      struct Node final {
+        RenderCommand command;
+        std::atomic<Node *> next{nullptr};
+      };
+
+      /// The node most recently pushed, producers swap it to append to the queue
+      std::atomic<Node *> head;
+      /// The node before the next command to execute, only accessed by the consumer
+      Node *tail;
+  };
+}
+
+#endif //RENDER_COMMAND_QUEUE_HPP
@@ -0,0 +1,76 @@
+//
+// Handle.hpp
+// Author: Antoine Bastide
+// Date: 16.10.2026
+//
+
+#ifndef HANDLE_HPP
+#define HANDLE_HPP
+
+#include <cstdint>
+#include <functional>
+
+#include "Engine/Types/Pool.hpp"
+
+namespace Engine {
+  /**
+   * Generational reference to an object allocated from a Pool. Unlike Ptr, it knows when the object it refers to was
+   * destroyed, even if its memory was reused for a new object since, and then behaves like a null pointer.
+   * @tparam T The type of the object, must be allocated from Pool<T>
+   */
+  template<typename T> class Handle final {
+    public:
+      constexpr Handle()
+        : ptr(nullptr), generation(0) {}
+
+      constexpr Handle(std::nullptr_t)
+        : ptr(nullptr), generation(0) {}
+
+      Handle(T *ptr)
+        : ptr(ptr), generation(ptr ? Pool<T>::Generation(ptr) : 0) {}
+
+      /// @returns The object this handle refers to, nullptr if it was destroyed
+      [[nodiscard]] T *get() const {
+        return valid() ? ptr : nullptr;
+      }
+
+      /// @returns True if the object this handle refers to is still alive, false if not
+      [[nodiscard]] bool valid() const {
+        return ptr && Pool<T>::Generation(ptr) == generation;
+      }
+
+      T *operator->() const {
+        return get();
+      }
+
+      T &operator*() const {
+        return *get();
+      }
+
+      operator bool() const {
+        return valid();
+      }
+
+      constexpr bool operator==(const Handle &other) const {
+        return ptr == other.ptr && generation == other.generation;
+      }
+
+      /// @returns The generation of the slot of the object when this handle was created
+      [[nodiscard]] constexpr uint32_t Generation() const {
+        return generation;
+      }
+    private:
+      friend struct std::hash<Handle>;
+
+      T *ptr;
+      uint32_t generation;
+  };
+}
+
+template<typename T> struct std::hash<Engine::Handle<T>> {
+  size_t operator()(const Engine::Handle<T> &handle) const noexcept {
+    return hash<T *>{}(handle.ptr) ^ static_cast<size_t>(handle.generation) << 1;
+  }
+};
+
+#endif //HANDLE_HPP
@@ -0,0 +1,113 @@
+//
+// Pool.hpp
+// Author: Antoine Bastide
+// Date: 16.10.2026
+//
+
+#ifndef POOL_HPP
+#define POOL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace Engine {
+  /**
+   * Slab allocator for objects of type T. Memory is reserved in chunks of contiguous slots that are never given back
+   * while the program runs, freed slots are reused in last in, first out order so that new objects land in memory that
+   * is still in cache. Each slot has a generation that changes every time it is allocated or freed, which is what
+   * Handle uses to detect that the object it points to was destroyed and its slot recycled.
+   * @tparam T The type of the pooled objects, its class operator new and delete should forward to this pool
+   * @tparam SlotsPerChunk The number of slots reserved at once when the pool is full
+   */
+  template<typename T, size_t SlotsPerChunk = 256> class Pool final {
+    public:
+      /// @returns Uninitialized memory for an object of type T
+      static void *Allocate() {
+        State &pool = state();
+        std::lock_guard lock(pool.mutex);
+        if (!pool.freeList) {
+          Slot *chunk = pool.chunks.emplace_back(std::make_unique<Slot[]>(SlotsPerChunk)).get();
+          // Link the new slots so that the first one of the chunk is allocated first
+          for (size_t i = SlotsPerChunk; i-- > 0;) {
+            chunk[i].next = pool.freeList;
+            pool.freeList = &chunk[i];
+          }
+        }
+
+        Slot *slot = pool.freeList;
+        pool.freeList = slot->next;
+        slot->generation.fetch_add(1, std::memory_order_release);
+        ++pool.size;
+        return slot->storage;
+      }
+
+      /// Gives the memory of the given object back to the pool, the object must already be destroyed
+      static void Free(void *ptr) {
+        if (!ptr)
+          return;
+
+        State &pool = state();
+        std::lock_guard lock(pool.mutex);
+        const auto slot = static_cast<Slot *>(ptr);
+        slot->generation.fetch_add(1, std::memory_order_release);
+        slot->next = pool.freeList;
+        pool.freeList = slot;
+        --pool.size;
+      }
+
+      /// @returns The current generation of the slot of the given object, odd while the object is alive
+      [[nodiscard]] static uint32_t Generation(const T *ptr) {
+        return reinterpret_cast<const Slot *>(ptr)->generation.load(std::memory_order_acquire);
+      }
+
+      /// @returns The number of objects currently allocated from the pool
+      [[nodiscard]] static size_t Size() {
+        State &pool = state();
+        std::lock_guard lock(pool.mutex);
+        return pool.size;
+      }
+
+      /// @returns The number of objects the pool can hold before reserving a new chunk
+      [[nodiscard]] static size_t Capacity() {
+        State &pool = state();
+        std::lock_guard lock(pool.mutex);
+        return pool.chunks.size() * SlotsPerChunk;
+      }
+    private:
+      /// Storage of a single object, the storage comes first so that a pointer to the object is a pointer to its slot
+      struct Slot final {
+        alignas(T) std::byte storage[sizeof(T)];
+        /// Incremented when the slot is allocated and when it is freed
+        std::atomic<uint32_t> generation{0};
+        /// The next free slot, only meaningful while this slot is free
+        Slot *next = nullptr;
+      };
+
+      /// The bookkeeping shared by all the objects of the pool
+      struct State final {
+        /// The chunks of slots reserved so far
+        std::vector<std::unique_ptr<Slot[]>> chunks;
+        /// The most recently freed slot, the next one to be allocated
+        Slot *freeList = nullptr;
+        /// The number of objects currently allocated
+        size_t size = 0;
+        /// Guards the free list, objects can be created and destroyed from any thread
+        std::mutex mutex;
+      };
+
+      Pool() = default;
+
+      /// @returns The state of the pool, never destroyed so that objects freed during static destruction stay valid
+      static State &state() {
+        static auto *pool = new State;
+        return *pool;
+      }
+  };
+}
+
+#endif //POOL_HPP
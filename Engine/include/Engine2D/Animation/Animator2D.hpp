@@ -24,6 +24,10 @@ namespace Engine2D::Animation {
       };
         REFLECT_ANIMATIONCONDITION
 
+      Animator2D() = default;
+      /// Copies the animations, parameters and transitions of the given animator
+      Animator2D(const Animator2D &other);
+
       /// Maps the given animation to it's name in the animator
       /// @note If an animation with the same name already exists, the new one will overwrite it
       void AddAnimation(const std::string &name, const Animation2D &animation);
@@ -187,13 +191,15 @@ namespace Engine2D::Animation {
       /// All the user defined animator transitions
       ENGINE_SERIALIZE std::unordered_map<std::string, std::vector<AnimationTransition>> transitions;
       /// The animation currently played by the animator
-      Animation2D *currentAnimation;
+      Animation2D *currentAnimation = nullptr;
       /// The name of the animation currently played by the animator
       ENGINE_SERIALIZE std::string currentAnimationName;
       /// The animation played by default by the animator
-      Animation2D *defaultAnimation;
+      Animation2D *defaultAnimation = nullptr;
       /// The name of the animation currently played by the animator
       ENGINE_SERIALIZE std::string defaultAnimationName;
+      /// The index of this animator in the list of animators of the animation system
+      size_t animationIndex = 0;
 
       void forward() override;
       void recall() override;
@@ -29,4 +29,16 @@
   bool _e_renderInEditor(const bool readOnly) override {\
     return false;\
 }
-#endif
\ No newline at end of file
+#endif
+
+  #define REFLECT_UPDATEACCESS\
+  static inline const bool _reg_UPDATEACCESS = [] {\
+    Engine::Reflection::ReflectionFactory::RegisterEnum<Engine2D::Behaviour::UpdateAccess>(\
+    "Engine2D::Behaviour::UpdateAccess", {\
+      std::pair<std::string, Engine2D::Behaviour::UpdateAccess>{"Shared", Engine2D::Behaviour::UpdateAccess::Shared},\
+      std::pair<std::string, Engine2D::Behaviour::UpdateAccess>{"ReadOnly", Engine2D::Behaviour::UpdateAccess::ReadOnly},\
+      std::pair<std::string, Engine2D::Behaviour::UpdateAccess>{"OwnEntity", Engine2D::Behaviour::UpdateAccess::OwnEntity},\
+      }\
+    );\
+    return true;\
+  }();
@@ -7,6 +7,8 @@
 #ifndef BEHAVIOUR_H
 #define BEHAVIOUR_H
 
+#include <concepts>
+
 #include "Engine/Types/Ptr.hpp"
 #include "Engine2D/Component2D.hpp"
 #include "Engine2D/Transform2D.hpp"
@@ -14,9 +16,35 @@
 #include "Behaviour.gen.hpp"
 
 namespace Engine2D {
+  namespace Physics {
+    class Physics2D;
+  }
+
   class Behaviour : public Component2D {
     SERIALIZE_BEHAVIOUR
+      friend class Scene;
+      friend class Entity2D;
+      friend class Physics::Physics2D;
     public:
+      /// Describes what a behaviour accesses during OnUpdate, behaviours that declare a narrower access than Shared are
+      /// updated in parallel on the worker threads and must not create or destroy entities or components
+      enum UpdateAccess {
+        /// Might read and write anything, updated serially in entity order after the parallel updates
+        Shared,
+        /// Only reads the scene through const accessors and only writes its own fields, updated in parallel first
+        ReadOnly,
+        /// Only reads and writes its own entity, its components and its children, entities of the same hierarchy are
+        /// updated serially and different hierarchies in parallel
+        OwnEntity
+      };
+        REFLECT_UPDATEACCESS
+
+      /// @returns What this behaviour accesses during OnUpdate, Shared by default
+      /// @note Only read when the scene rebuilds its update lists, so it should not change during the behaviour's lifetime
+      [[nodiscard]] virtual UpdateAccess Access() const {
+        return Shared;
+      }
+
       /// Called before the first update.
       virtual void OnInitialize() {}
       /// Called before the first update and after deserialization to bind input correctly.
@@ -41,9 +69,59 @@ namespace Engine2D {
       virtual void OnTriggerStay2D(const Engine::Ptr<Physics::Collider2D> &collider) {}
       /// Called when this entity is stops triggered by a given entity, required the entity to have a Collider2D component
       virtual void OnTriggerExit2D(const Engine::Ptr<Physics::Collider2D> &collider) {}
+    protected:
+      /// Called by the reflection factory once a behaviour of the concrete type T has been created
+      template<typename T> static void _e_onCreate(T *behaviour) {
+        behaviour->hooks = overriddenHooks<T>();
+      }
     private:
+      static constexpr uint8_t UpdateHook = 1 << 0;
+      static constexpr uint8_t FixedUpdateHook = 1 << 1;
+      static constexpr uint8_t CollisionEnterHook = 1 << 2;
+      static constexpr uint8_t CollisionStayHook = 1 << 3;
+      static constexpr uint8_t CollisionExitHook = 1 << 4;
+      static constexpr uint8_t TriggerEnterHook = 1 << 5;
+      static constexpr uint8_t TriggerStayHook = 1 << 6;
+      static constexpr uint8_t TriggerExitHook = 1 << 7;
+      static constexpr uint8_t AllHooks = 0xFF;
+
+      /// The hooks overridden by this behaviour, the engine only calls those
+      uint8_t hooks = AllHooks;
+      /// Whether this behaviour is in the dispatch lists of its scene, it stays in them while it is inactive
+      bool dispatched = false;
+
       using Component2D::forward;
       using Component2D::recall;
+
+      /// @returns The hooks overridden by the behaviour type T
+      template<typename T> static constexpr uint8_t overriddenHooks() {
+        // A hook that is not overridden is still a member of Behaviour, private overrides can not be inspected from here
+        // so they are treated as overridden
+        uint8_t hooks = 0;
+        if constexpr (!requires { { &T::OnUpdate } -> std::same_as<decltype(&Behaviour::OnUpdate)>; })
+          hooks |= UpdateHook;
+        if constexpr (!requires { { &T::OnFixedUpdate } -> std::same_as<decltype(&Behaviour::OnFixedUpdate)>; })
+          hooks |= FixedUpdateHook;
+        if constexpr (!requires {
+          { &T::OnCollisionEnter2D } -> std::same_as<decltype(&Behaviour::OnCollisionEnter2D)>;
+        })
+          hooks |= CollisionEnterHook;
+        if constexpr (!requires {
+          { &T::OnCollisionStay2D } -> std::same_as<decltype(&Behaviour::OnCollisionStay2D)>;
+        })
+          hooks |= CollisionStayHook;
+        if constexpr (!requires {
+          { &T::OnCollisionExit2D } -> std::same_as<decltype(&Behaviour::OnCollisionExit2D)>;
+        })
+          hooks |= CollisionExitHook;
+        if constexpr (!requires { { &T::OnTriggerEnter2D } -> std::same_as<decltype(&Behaviour::OnTriggerEnter2D)>; })
+          hooks |= TriggerEnterHook;
+        if constexpr (!requires { { &T::OnTriggerStay2D } -> std::same_as<decltype(&Behaviour::OnTriggerStay2D)>; })
+          hooks |= TriggerStayHook;
+        if constexpr (!requires { { &T::OnTriggerExit2D } -> std::same_as<decltype(&Behaviour::OnTriggerExit2D)>; })
+          hooks |= TriggerExitHook;
+        return hooks;
+      }
   };
 } // Engine2D
 
@@ -8,6 +8,9 @@
 #define COMPONENT2D_H
 
 #include <memory>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
 
 #include "Engine/Reflection/Reflectable.hpp"
 #include "Engine/Types/Ptr.hpp"
@@ -26,6 +29,7 @@ namespace Engine2D {
     SERIALIZE_COMPONENT2D
       friend class Scene;
       friend class Entity2D;
+      friend class Prefab;
       friend class Transform2D;
     public:
       ~Component2D() override = default;
@@ -47,6 +51,8 @@ namespace Engine2D {
       ENGINE_SERIALIZE_HIDDEN bool active;
 
       Component2D();
+      /// Copies the state of the given component, the copy is not attached to any entity
+      Component2D(const Component2D &other);
 
       /// Internal call to forward this component to the system that handles it
       virtual void forward() {}
@@ -55,6 +61,34 @@ namespace Engine2D {
     private:
       /// The entity this component is attached to
       Engine::Ptr<Entity2D> entity;
+      /// The id of the type of this component, set when it is attached to an entity
+      uint32_t typeId;
+      /// The index of this component in the list of components of its type in its scene
+      size_t typeIndex;
+  };
+
+  /// Assigns a unique id to each component type, so that entities and scenes can look components up by type in
+  /// constant time instead of casting each of their components
+  class ComponentType final {
+    public:
+      template<typename T> requires std::is_base_of_v<Component2D, T>
+      /// @returns The id of the given component type
+      [[nodiscard]] static uint32_t Id() {
+        static const uint32_t id = Id(typeid(T));
+        return id;
+      }
+
+      /// @returns The id of the given component type
+      [[nodiscard]] static uint32_t Id(std::type_index type);
+      /// @returns The id of the type of the given component
+      [[nodiscard]] static uint32_t Of(const Component2D &component);
+    private:
+      /// The ids assigned so far, ids are assigned in the order types are first looked up
+      inline static std::unordered_map<std::type_index, uint32_t> ids;
+      /// Guards the ids, types can be looked up for the first time from any thread
+      inline static std::mutex mutex;
+
+      ComponentType() = default;
   };
 }
 
@@ -7,11 +7,13 @@
 #ifndef ENTITY2D_H
 #define ENTITY2D_H
 
+#include <atomic>
 #include <string>
 #include <vector>
 
 #include "Engine/Event.hpp"
 #include "Engine/Reflection/Reflectable.hpp"
+#include "Engine/Types/Handle.hpp"
 #include "Engine/Types/Ptr.hpp"
 #include "Engine2D/Behaviour.hpp"
 #include "Engine2D/Component2D.hpp"
@@ -44,6 +46,8 @@ namespace Engine2D {
   class Entity2D final : public Engine::Reflection::Reflectable {
     SERIALIZE_ENTITY2D
       friend class Scene;
+      friend class Prefab;
+      friend class WorldStreamer;
       friend class Transform2D;
       friend class SceneManager;
       friend class Physics::Physics2D;
@@ -53,11 +57,12 @@ namespace Engine2D {
       friend class Editor::History::SelectEntityCommand;
       friend class Editor::History::DeleteEntityCommand;
     public:
-      /// The name of the entity.
-      std::string name;
-
       ~Entity2D() override;
 
+      /// Entities are allocated from a pool so that spawning and destroying many of them does not go through the heap
+      static void *operator new(size_t size);
+      static void operator delete(void *ptr);
+
       /// Equality operator that checks if the current entity is the same as the given entity
       bool operator==(const Entity2D &entity) const;
       /// Inequality operator that checks if the current entity is the same as the given entity
@@ -66,6 +71,16 @@ namespace Engine2D {
       /// @returns The pointer to this entity's transform component
       [[nodiscard]] Engine::Ptr<Transform2D> Transform() const;
 
+      /// Renames this entity
+      /// @note Can be called from a behaviour updated in parallel on its own entity, the name index of the scene is
+      /// locked while the entity is renamed and while entities are looked up by name
+      void SetName(const std::string &name);
+      /// @returns The name of this entity
+      [[nodiscard]] const std::string &Name() const;
+
+      /// @returns A handle to this entity that becomes null once the entity is freed, even if its memory is reused
+      [[nodiscard]] Engine::Handle<Entity2D> Handle() const;
+
       /// @returns The id of this entity
       [[nodiscard]] uint64_t Id() const;
       /// @returns The id of this entity
@@ -80,10 +95,12 @@ namespace Engine2D {
         component->entity = this;
         T *ptr = component.get();
         allComponents.emplace_back(std::move(component));
+        registerComponent(ptr, ComponentType::Id<T>());
         if constexpr (std::is_base_of_v<Behaviour, T>) {
           auto behaviour = static_cast<Behaviour *>(ptr);
-          behavioursToInitialize.emplace_back(behaviour);
-          behaviours.emplace_back(behaviour);
+          behaviour->hooks = Behaviour::overriddenHooks<T>();
+          queueInitialization(behaviour);
+          addBehaviour(behaviour);
         } else {
           components.emplace_back(ptr);
           ptr->forward();
@@ -95,12 +112,16 @@ namespace Engine2D {
        * Try's to find a component of the given type on the current entity
        * @tparam T The type of the component to find, must inherit from Component2D
        * @return The first component that matches the given type found on the current entity, nullptr if none were found
+       * @note Constant time if T is final, otherwise the components of the entity are cast one by one
        */
       template<typename T> requires std::is_base_of_v<Component2D, T>
       [[nodiscard]] Engine::Ptr<T> GetComponent() const {
         if constexpr (std::is_same_v<T, Transform2D>)
           return transform.get();
-        if constexpr (std::is_base_of_v<Behaviour, T>) {
+        else if constexpr (std::is_final_v<T>)
+          // No other type can derive from T, so the first component of exactly this type is the one to return
+          return static_cast<T *>(componentSlot(ComponentType::Id<T>()));
+        else if constexpr (std::is_base_of_v<Behaviour, T>) {
           for (auto &component: behaviours)
             if (auto casted = dynamic_cast<T *>(component.get()))
               return casted;
@@ -147,6 +168,8 @@ namespace Engine2D {
        */
       template<typename T> requires std::is_base_of_v<Component2D, T>
       [[nodiscard]] bool HasComponent() const {
+        if constexpr (std::is_final_v<T> && !std::is_same_v<T, Transform2D>)
+          return componentSlot(ComponentType::Id<T>()) != nullptr;
         return GetComponent<T>() != nullptr;
       }
 
@@ -164,26 +187,19 @@ namespace Engine2D {
       /// Removes the given component to the current entity
       template<typename T> requires std::is_base_of_v<Component2D, T> && (!std::is_same_v<T, Transform2D>)
       void RemoveComponent(const Engine::Ptr<T> &component) {
+        unregisterComponent(component.get());
         if constexpr (std::is_base_of_v<Behaviour, T>) {
-          const auto behaviour = static_cast<Behaviour *>(*component);
+          const auto behaviour = static_cast<Behaviour *>(component.get());
           behaviour->OnDestroy();
-          std::erase_if(
-            behaviours, [component](const std::unique_ptr<Component2D> &comp) {
-              return comp.get() == *component;
-            }
-          );
+          removeBehaviour(behaviour);
         } else {
           component->recall();
-          std::erase_if(
-            components, [component](const std::unique_ptr<Component2D> &comp) {
-              return comp.get() == *component;
-            }
-          );
+          std::erase(components, static_cast<Component2D *>(component.get()));
         }
 
         std::erase_if(
           allComponents, [component](const std::unique_ptr<Component2D> &comp) {
-            return comp.get() == *component;
+            return comp.get() == component.get();
           }
         );
       }
@@ -198,7 +214,15 @@ namespace Engine2D {
         if constexpr (std::is_same_v<T, Transform2D>)
           return {transform.get()};
         std::vector<Engine::Ptr<T>> res;
-        if constexpr (std::is_base_of_v<Behaviour, T>) {
+        if constexpr (std::is_final_v<T>) {
+          // Only compare the type ids, and only if the entity has at least one component of this type
+          const uint32_t typeId = ComponentType::Id<T>();
+          if (!componentSlot(typeId))
+            return res;
+          for (auto &component: allComponents)
+            if (component->typeId == typeId)
+              res.push_back(static_cast<T *>(component.get()));
+        } else if constexpr (std::is_base_of_v<Behaviour, T>) {
           for (auto &component: behaviours)
             if (auto casted = dynamic_cast<T *>(component.get()))
               res.push_back(casted);
@@ -292,6 +316,12 @@ namespace Engine2D {
         float rotation = 0.0f, glm::vec2 scale = glm::vec2(1.0f, 1.0f), const Engine::Ptr<Entity2D> &parent = {}
       );
     private:
+      /// The name of the entity
+      ENGINE_SERIALIZE std::string name;
+      /// The name under which this entity is indexed in its scene
+      std::string indexedName;
+      /// The index of this entity in the list of entities with its indexed name
+      size_t nameIndex;
       /// If the current entity is active in the scene
       ENGINE_SERIALIZE bool active;
       /// If the parents of the current entity are active in the scene
@@ -300,10 +330,12 @@ namespace Engine2D {
       ENGINE_SERIALIZE bool isStatic;
       /// Whether this entity is now destroyed and no longer active
       ENGINE_SERIALIZE bool destroyed;
+      /// Whether this entity was added to its scene
+      bool initialized;
       /// How long an entity stays alive after being flagged to be destroyed
       float timeToLive;
 
-      inline static uint64_t nextId = 1;
+      inline static std::atomic<uint64_t> nextId = 1;
       /// The id of this entity
       uint64_t id;
 
@@ -317,6 +349,12 @@ namespace Engine2D {
       std::vector<Engine::Ptr<Behaviour>> behaviours;
       /// The list of behaviours to initialize
       std::vector<Engine::Ptr<Behaviour>> behavioursToInitialize;
+      /// The hooks overridden by at least one of the behaviours of this entity
+      uint8_t behaviourHooks;
+      /// Bit i is set if this entity has a component whose type id is i, only covers the first 64 type ids
+      uint64_t componentMask;
+      /// The first component of each type attached to this entity, indexed by component type id
+      std::vector<Component2D *> componentSlots;
       /// The scene this entity is in
       Engine::Ptr<Engine2D::Scene> scene;
       /// All the user defined input callbacks
@@ -331,6 +369,23 @@ namespace Engine2D {
       );
       #endif
 
+      /// @returns The first component of this entity whose type has the given id, nullptr if there is none
+      [[nodiscard]] Component2D *componentSlot(const uint32_t typeId) const {
+        if (typeId < 64)
+          return componentMask >> typeId & 1 ? componentSlots[typeId] : nullptr;
+        return typeId < componentSlots.size() ? componentSlots[typeId] : nullptr;
+      }
+      /// Indexes the given component by its type in this entity and in the scene
+      void registerComponent(Component2D *component, uint32_t typeId);
+      /// Removes the given component from the type indexes of this entity and of the scene
+      void unregisterComponent(Component2D *component);
+      /// Adds the given behaviour to the behaviours to initialize, and this entity to the entities of its scene to
+      /// initialize if it is already in it
+      void queueInitialization(const Engine::Ptr<Behaviour> &behaviour);
+      /// Adds the given behaviour to the behaviours of this entity and to the hook dispatch of its scene
+      void addBehaviour(const Engine::Ptr<Behaviour> &behaviour);
+      /// Removes the given behaviour from the behaviours of this entity and from the hook dispatch of its scene
+      void removeBehaviour(const Engine::Ptr<Behaviour> &behaviour);
       /// Initializes the entity, setting its parent to the main parent if none is set.
       void initialize();
       /// Cleans up resources when the game ends
@@ -342,6 +397,12 @@ namespace Engine2D {
       void onDeserialize(
         Engine::Reflection::Format format, const Engine::JSON &json, const Engine::Ptr<Engine2D::Scene> &scene
       );
+      /// Attaches the deserialized entity to the given scene under the given parent, the entity is not added to the
+      /// entities of the scene, entities that are not initialized yet queue their behaviours to be initialized
+      void onDeserialize(
+        Engine::Reflection::Format format, const Engine::JSON &json, const Engine::Ptr<Engine2D::Scene> &scene,
+        const Engine::Ptr<Entity2D> &parent
+      );
   };
 }
 
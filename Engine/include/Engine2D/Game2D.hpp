@@ -7,10 +7,15 @@
 #ifndef GAME2D_H
 #define GAME2D_H
 
+#include <array>
 #include <thread>
 #include <cmrc/cmrc.hpp>
 
 #include "Engine/RenderingHeaders.hpp"
+#include "Engine/Threading/RenderCommandQueue.hpp"
+#include "Engine/Types/Ptr.hpp"
+#include "Engine2D/HeadlessReport.hpp"
+#include "Engine2D/Rendering/FrameSnapshot.hpp"
 
 using ResourceLoader = std::function<cmrc::file(const std::string &)>;
 
@@ -26,6 +31,8 @@ namespace Engine {
 }
 
 namespace Engine2D {
+  class Scene;
+
   namespace Animation {
     class AnimationSystem;
   }
@@ -64,6 +71,8 @@ namespace Engine2D {
       [[nodiscard]] static float DeltaTime();
       /// @returns The fixed time span between the physics updates
       [[nodiscard]] static float FixedDeltaTime();
+      /// @returns True if the game is idle and runs at the idle frame rate, false if not
+      [[nodiscard]] static bool Idle();
 
       /// Set's the given resource loader of the game to load embedded resources
       /// @param resourceLoader The resource loader that contains the resources to load
@@ -73,9 +82,57 @@ namespace Engine2D {
       /// Quits the game
       static void Quit();
 
+      template<typename F, typename R = std::invoke_result_t<F>>
+      /**
+       * Runs the given command on the thread that owns the OpenGL context. When called from another thread, such as the
+       * render thread or a thread loading a scene, the command is queued and executed before one of the next frames is
+       * drawn, otherwise it is executed immediately.
+       * @param command The command to run, it can make any OpenGL call
+       * @returns A future that holds the result of the command, it can be ignored if the result is not needed
+       * @note Waiting on the future from the render thread or from within a render command blocks forever
+       */
+      static std::future<R> RunOnRenderThread(F &&command) {
+        // The command can run right away when the calling thread owns the context, or when there is no context at all
+        const auto thread = std::this_thread::get_id();
+        if (!instance || instance->headlessMode ||
+            thread == (instance->renderThreadEnabled ? instance->renderThread.get_id() : instance->mainThread)) {
+          std::packaged_task<R()> task(std::forward<F>(command));
+          std::future<R> future = task.get_future();
+          task();
+          return future;
+        }
+
+        std::future<R> future = instance->renderCommands.Submit(std::forward<F>(command));
+        instance->wakeRenderThread();
+        return future;
+      }
+
       /// Start's and Run's the current game
       /// @note Do not call this function yourself in your code, it will be called in the main.cpp of your game
       void Run();
+      /**
+       * Advances the active scene by the given number of ticks as fast as possible, without creating a window or an
+       * OpenGL context, nothing is rendered.
+       * @param ticks The number of ticks to simulate
+       * @param fixedDeltaTime The time step of each tick, in seconds
+       * @returns The time spent in each system during the run
+       * @note Resources that need the GPU (textures, shaders) can not be loaded in this mode
+       */
+      HeadlessReport RunHeadless(size_t ticks, float fixedDeltaTime);
+      /**
+       * Advances each of the given scenes by the given number of ticks as fast as possible and in parallel, without
+       * creating a window or an OpenGL context, nothing is rendered.
+       * Each scene is stepped on its own thread with its own clock and physics settings, scenes are independent and
+       * must not access each other.
+       * @param scenes The scenes to simulate, initialized first if they were not
+       * @param ticks The number of ticks to simulate for each scene
+       * @param fixedDeltaTime The time step of each tick, in seconds
+       * @returns The time spent in each system of each scene, in the order of the given scenes
+       * @note Resources that need the GPU (textures, shaders) can not be loaded in this mode
+       */
+      std::vector<HeadlessReport> RunHeadless(
+        const std::vector<Engine::Ptr<Scene>> &scenes, size_t ticks, float fixedDeltaTime
+      );
 
       virtual ~Game2D();
     protected:
@@ -120,23 +177,26 @@ namespace Engine2D {
       float targetFrameRate;
       /// The rate at which the game should update
       float targetRenderRate;
-      /// Counts the number of frames rendered during the current second of elapsed time
-      int frameCounter;
-      /// Simple accumulator to count to 1 second
-      float oneSecondTimer;
       /// The time at which the previous frame was run
       std::chrono::time_point<std::chrono::steady_clock> lastTime;
 
-      /// Timer used to check if the game is ready for the next physics update
-      float physicsAccumulator;
+      /// Whether the game is idle, in which case it runs at the idle frame rate
+      bool idle;
+      /// The time at which the last keyboard or mouse input was received
+      std::chrono::time_point<std::chrono::steady_clock> lastInputTime;
 
       /// Whether the game is running in headless mode (no window)
       bool headlessMode;
 
+      /// Whether the game is rendered on its own thread, set from the threading model when the game starts
+      bool renderThreadEnabled;
+
+      /// The thread the game was created on, which runs the update loop and owns the context without a render thread
+      std::thread::id mainThread;
+
       /// The update loop called on the main thread
       void updateLoop();
 
-      #if MULTI_THREAD
       /// Whether the main thread is finished and ready to sync with the render thread
       bool updateFinished;
       /// Whether the render thread is finished and ready to sync with the main thread
@@ -148,15 +208,29 @@ namespace Engine2D {
       /// The thread responsible for rendering the game
       std::thread renderThread;
 
-      std::mutex controlMutex;
-      std::condition_variable controlCV;
-      std::function<void()> renderThreadCallback;
-      bool callbackPending;
+      /// The commands to run on the render thread before drawing the next frame
+      Engine::Threading::RenderCommandQueue renderCommands;
+
+      /// The snapshots the update thread writes to and the render thread reads from, in turns
+      std::array<Rendering::FrameSnapshot, 2> frameSnapshots;
+      /// The index of the snapshot the update thread is currently writing to
+      size_t snapshotIndex;
+      /// The snapshot handed off to the render thread, nullptr if no frame is ready to be rendered
+      const Rendering::FrameSnapshot *renderSnapshot;
+
+      /// Blocks until the render thread has drawn the frame it was handed, so that the scene the frame was extracted
+      /// from can be destroyed. Returns right away without a render thread or when called from the render thread
+      static void waitForRenderedFrame();
 
       /// The render loop called on the render thread
       void renderLoop();
-      #endif
+      /// Wakes up the render thread if it is waiting for a frame so that it runs the queued commands
+      void wakeRenderThread();
+      /// Runs the queued render commands for at most the render command budget
+      void drainRenderCommands();
 
+      /// Starts the worker threads and pins the engine threads according to the threading settings
+      void initializeThreading();
       /// Initialize's the graphics code
       void initializeGraphicPipeline();
       /// Initialize's the game code
@@ -165,6 +239,11 @@ namespace Engine2D {
       static void processInput();
       /// Limits the frame rate of the game if needed
       void limitFrameRate() const;
+      /// Checks if the game should be idle based on the state of its window and the time since the last input
+      /// @returns True if the game is idle, false if not
+      bool updateIdleState();
+      /// Waits for events until the next idle frame is due or until the game is no longer idle
+      void waitWhileIdle();
       /// Quits the game
       void quit();
 
@@ -177,6 +256,8 @@ namespace Engine2D {
       void renderFrame() const;
       /// Makes this game instance a headless instance of the game
       void setAsHeadless();
+      /// Runs a single headless tick of the given scene, adding the time spent in each system to the given report
+      static void tickHeadless(Scene &scene, HeadlessReport &report);
       /// Check if running in headless mode
       [[nodiscard]] bool IsHeadless() const {
         return headlessMode;
@@ -185,6 +266,9 @@ namespace Engine2D {
       // OpenGL callbacks
       static void framebuffer_size_callback(GLFWwindow *window, int width, int height);
       static void scroll_callback(GLFWwindow *window, double xOffset, double yOffset);
+      static void key_callback(GLFWwindow *window, int key, int scancode, int action, int mods);
+      static void cursor_position_callback(GLFWwindow *window, double x, double y);
+      static void mouse_button_callback(GLFWwindow *window, int button, int action, int mods);
       static void window_close_callback(GLFWwindow *window);
   };
 } // Engine2D
@@ -0,0 +1,55 @@
+//
+// HeadlessReport.hpp
+// Author: Antoine Bastide
+// Date: 16.10.2026
+//
+
+#ifndef HEADLESS_REPORT_HPP
+#define HEADLESS_REPORT_HPP
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Engine2D {
+  /// Timings of a headless simulation run, used to know how many ticks per second each system can sustain
+  struct HeadlessReport final {
+    /// Time spent in a single system during the run
+    struct System final {
+      /// The name of the system
+      std::string name;
+      /// The total time spent in the system, in seconds
+      double seconds = 0.0;
+    };
+
+    /// The number of ticks that were simulated
+    size_t ticks = 0;
+    /// The fixed time step used for each tick, in seconds
+    float deltaTime = 0.0f;
+    /// The total wall clock time of the run, in seconds
+    double seconds = 0.0;
+    /// The time spent in each system, in the order they are run during a tick
+    std::vector<System> systems;
+
+    /// @returns The number of ticks simulated per second of wall clock time
+    [[nodiscard]] double TicksPerSecond() const {
+      return seconds > 0.0 ? static_cast<double>(ticks) / seconds : 0.0;
+    }
+
+    /// @returns The number of ticks per second the given system could sustain if it was the only one running
+    [[nodiscard]] double TicksPerSecond(const System &system) const {
+      return system.seconds > 0.0 ? static_cast<double>(ticks) / system.seconds : 0.0;
+    }
+
+    /// Writes a human-readable summary of the report to the given stream
+    void Print(std::ostream &stream) const {
+      stream << "Simulated " << ticks << " ticks of " << deltaTime << "s in " << seconds << "s (" << TicksPerSecond()
+        << " ticks/s)\n";
+      for (const auto &system: systems)
+        stream << "  " << system.name << ": " << system.seconds << "s (" << TicksPerSecond(system) << " ticks/s)\n";
+    }
+  };
+}
+
+#endif //HEADLESS_REPORT_HPP
@@ -139,8 +139,8 @@ namespace Engine2D {
       /// The VBO used to send particle data
       uint instanceVBO;
 
-      /// Renders the particle system
-      void updateAndRender(uint textureIndex, float *data);
+      /// Simulates the particle system and writes at most instanceCount particles to the given buffer
+      void updateAndRender(uint textureIndex, float *data, int instanceCount);
       /// Updates the dead particle at the given index and brings it back to life
       void respawnParticle();
 
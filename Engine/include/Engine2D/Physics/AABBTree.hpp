@@ -0,0 +1,121 @@
+//
+// AABBTree.hpp
+// Author: Antoine Bastide
+// Date: 16.10.2026
+//
+
+#ifndef AABB_TREE_HPP
+#define AABB_TREE_HPP
+
+#include <vector>
+
+#include "Engine2D/Physics/Collider2D.hpp"
+
+namespace Engine2D::Physics {
+  /**
+   * Dynamic bounding volume hierarchy of the bounds of the active colliders, used by the broad phase when the world is
+   * too large or too sparse for the collision grid.
+   * Each leaf stores the bounds of a collider enlarged by a margin, a leaf is only moved in the tree once the collider
+   * leaves these enlarged bounds, and the tree is kept balanced by rotating its nodes as leaves are inserted and
+   * removed.
+   */
+  class AABBTree {
+    friend class Physics2D;
+
+    /// A node of the tree, either a leaf that holds a collider or a branch with exactly two children
+    struct Node final {
+      /// The enlarged bounds of the collider of a leaf, or the bounds of the two children of a branch
+      Collider2D::AABB aabb;
+      /// The index of the parent node, -1 for the root, or the next free node while this node is unused
+      int32_t parent = -1;
+      /// The index of the first child of a branch, -1 for leaves
+      int32_t left = -1;
+      /// The index of the second child of a branch, -1 for leaves
+      int32_t right = -1;
+      /// The length of the longest path from this node to a leaf, 0 for leaves and -1 for unused nodes
+      int32_t height = 0;
+      /// The index of the collider of a leaf in the active colliders of the current step
+      uint32_t index = 0;
+
+      [[nodiscard]] bool isLeaf() const {
+        return left == -1;
+      }
+    };
+
+    /// The nodes of the tree, unused ones are chained in a free list to be reused
+    std::vector<Node> nodes;
+    /// The index of the root node, -1 if the tree is empty
+    int32_t root;
+    /// The index of the first unused node, -1 if there are none
+    int32_t freeList;
+    /// The number of leaves in the tree
+    size_t leafCount;
+    /// The nodes left to visit by a query, kept between queries to avoid allocating
+    std::vector<int32_t> stack;
+
+    AABBTree();
+
+    /// Adds a leaf for the given bounds of the active collider at the given index
+    /// @returns The index of the leaf
+    int32_t createLeaf(const Collider2D::AABB &aabb, uint32_t index);
+    /// Removes the given leaf from the tree
+    void destroyLeaf(int32_t leaf);
+    /// Sets the index of the active collider of the given leaf and moves the leaf if its collider left its bounds
+    /// @returns True if the leaf was moved, false if not
+    bool moveLeaf(int32_t leaf, const Collider2D::AABB &aabb, uint32_t index);
+    /// Removes all the leaves of the tree
+    void clear();
+    /// @returns True if the tree has no leaf, false if not
+    [[nodiscard]] bool empty() const;
+
+    template<typename F>
+    /// Calls the given function with the index of the active collider of every leaf whose bounds overlap the given ones
+    void query(const Collider2D::AABB &aabb, F &&callback) {
+      if (root == -1)
+        return;
+
+      stack.clear();
+      stack.push_back(root);
+      while (!stack.empty()) {
+        const Node &node = nodes[stack.back()];
+        stack.pop_back();
+        if (!overlaps(node.aabb, aabb))
+          continue;
+
+        if (node.isLeaf())
+          callback(node.index);
+        else {
+          stack.push_back(node.left);
+          stack.push_back(node.right);
+        }
+      }
+    }
+
+    /// @returns The index of an unused node, the nodes are grown if there are none
+    int32_t allocateNode();
+    /// Adds the given node to the free list
+    void freeNode(int32_t node);
+    /// Places the given leaf next to the node that grows the bounds of the tree the least
+    void insertLeaf(int32_t leaf);
+    /// Detaches the given leaf from the tree, its parent is replaced by its sibling
+    void removeLeaf(int32_t leaf);
+    /// Rotates the given node with its highest child if their heights differ by more than one
+    /// @returns The index of the node that took the place of the given one
+    int32_t balance(int32_t node);
+    /// Recomputes the bounds and heights of the given node and of its parents, balancing each one of them
+    void refit(int32_t node);
+
+    /// @returns The given bounds enlarged by a margin proportional to their size
+    static Collider2D::AABB fatten(const Collider2D::AABB &aabb);
+    /// @returns The smallest bounds that contain the two given ones
+    static Collider2D::AABB combine(const Collider2D::AABB &a, const Collider2D::AABB &b);
+    /// @returns The perimeter of the given bounds, used as their cost when choosing where to insert a leaf
+    static float perimeter(const Collider2D::AABB &aabb);
+    /// @returns True if the first bounds entirely contain the second ones, false if not
+    static bool contains(const Collider2D::AABB &a, const Collider2D::AABB &b);
+    /// @returns True if the two given bounds overlap, false if not
+    static bool overlaps(const Collider2D::AABB &a, const Collider2D::AABB &b);
+  };
+}
+
+#endif //AABB_TREE_HPP
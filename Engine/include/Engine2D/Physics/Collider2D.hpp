@@ -36,6 +36,7 @@ namespace Engine2D::Physics {
       friend class Collisions;
       friend class Rigidbody2D;
       friend class CollisionGrid;
+      friend class AABBTree;
       friend class Engine2D::Entity2D;
     public:
       enum ColliderType {
@@ -79,18 +80,22 @@ namespace Engine2D::Physics {
       std::vector<glm::vec2> vertices;
       /// The vertices that make up the initial collider transformed to match its current position, rotation and scale.
       std::vector<glm::vec2> transformedVertices;
-      /// Weather or not this collider has been initialized or not
-      bool initialized;
       /// The axis-aligned bounding box  of this rigidbody.
       AABB aabb;
-      /// The model matrix of the rigidbody last time it changed
-      glm::mat4 lastModelMatrix;
+      /// The version of the transform the axis-aligned bounding box was computed for, 0 if it was never computed
+      uint32_t transformVersion;
       /// The rigidbody attached to the entity this collider is attached to
       Engine::Ptr<Rigidbody2D> rigidbody;
       /// The points at which this rigidbody collided with another rigidbody
       std::vector<glm::vec2> contactPoints;
+      /// The index of this collider in the list of colliders of the physics system
+      size_t physicsIndex;
+      /// The index of the leaf of this collider in the AABB tree of the physics system, -1 if it is not in it
+      int32_t treeProxy;
 
       Collider2D();
+      /// Copies the settings and shape of the given collider, its physics state is not copied
+      Collider2D(const Collider2D &other);
 
       void forward() override;
       void recall() override;
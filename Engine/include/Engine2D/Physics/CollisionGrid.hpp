@@ -10,11 +10,9 @@
 #include <vector>
 #include <glm/glm.hpp>
 
-#include "Engine/Types/Ptr.hpp"
+#include "Engine2D/Physics/Collider2D.hpp"
 
 namespace Engine2D::Physics {
-  class Collider2D;
-
   class CollisionGrid {
     friend class Physics2D;
 
@@ -22,13 +20,15 @@ namespace Engine2D::Physics {
     glm::vec2 topRight;
     glm::vec2 cellSize;
     glm::vec<2, size_t> gridSize;
-    std::vector<std::vector<std::vector<Engine::Ptr<Collider2D>>>> grid;
+    /// The indices of the active colliders that overlap each cell
+    std::vector<std::vector<std::vector<uint32_t>>> grid;
 
     CollisionGrid();
     explicit CollisionGrid(glm::vec<2, size_t> gridSize);
     void setGridSize(glm::vec<2, size_t> gridSize);
 
-    void update(const std::vector<Engine::Ptr<Collider2D>> &colliders);
+    /// Places the given bounds in the cells they overlap
+    void update(const std::vector<Collider2D::AABB> &aabbs);
   };
 }
 
@@ -10,6 +10,7 @@
 #include <unordered_set>
 
 #include "Engine/Types/Ptr.hpp"
+#include "Engine2D/Physics/AABBTree.hpp"
 #include "Engine2D/Physics/CollisionGrid.hpp"
 #include "Engine2D/Physics/CollisionManifold.hpp"
 
@@ -20,6 +21,10 @@ namespace Engine {
 namespace Engine2D {
   class Scene;
   class Entity2D;
+
+  namespace Rendering {
+    class Renderer2D;
+  }
 }
 
 namespace Engine2D::Physics {
@@ -51,25 +56,41 @@ namespace Engine2D::Physics {
     friend class Collider2D;
     friend class Engine2D::Scene;
     friend class Engine::Settings;
+    friend class Rendering::Renderer2D;
 
     enum CollisionEventType {
       Stay, Enter, Exit
     };
 
+    /// The scene this system is a part of
+    Scene *scene;
     bool initialized;
+    /// The number of steps simulated so far
+    uint64_t stepCount;
+    /// How far the simulation time is between the last step and the next one, from 0 to 1, used to interpolate rendering
+    float interpolation;
     /// If the collision grid needs to be resized
     bool collisionGridNeedsResizing;
     /// The spacial partition of the screen for collisions
     CollisionGrid collisionGrid;
+    /// The bounding volume hierarchy of the active colliders, only filled while the tree broad phase is used
+    AABBTree aabbTree;
 
-    /// The list of all the colliders that are in the game
+    /// The list of all the colliders that are in the game, each collider stores its index in this list
     std::vector<Engine::Ptr<Collider2D>> colliders;
     /// The list of colliders to add to the future physics simulations steps
     std::vector<Engine::Ptr<Collider2D>> collidersToAdd;
     /// The list of colliders to remove from the future physics simulations steps
     std::unordered_set<Engine::Ptr<Collider2D>> collidersToRemove;
-    /// The list of currently active rigidbodies
+    /// The list of currently active colliders
     std::vector<Engine::Ptr<Collider2D>> activeColliders;
+    /// The bounds of each active collider, stored in the same order as activeColliders so that the grid and the broad
+    /// phase iterate contiguous memory instead of going through each collider
+    std::vector<Collider2D::AABB> activeAABBs;
+    /// The rigidbody of each active collider, stored in the same order as activeColliders, nullptr if it has none
+    std::vector<Rigidbody2D *> activeBodies;
+    /// The active rigidbodies that are not kinematic, each one appears only once even if it has multiple colliders
+    std::vector<Rigidbody2D *> dynamicBodies;
 
     /// The list of pairs of rigidbodies that had a contact during this frame
     std::vector<ContactPair> contactPairs;
@@ -86,14 +107,27 @@ namespace Engine2D::Physics {
 
     /// Simulates a step of the physics simulation
     void step();
-    /// Filters all the colliders in the game and keeps only the ones that are active
+    /// Filters all the colliders in the game and keeps only the ones that are active, along with their rigidbodies
     void findActiveColliders();
+    /// Integrates the velocity of all the dynamic rigidbodies
+    void integrateBodies() const;
+    /// Updates the AABB of all the active colliders in parallel
+    void computeAABBs();
     /// Calls the correct behaviour notification function
     static void notifyCollisions(
       const Engine::Ptr<Collider2D> &sender, const Engine::Ptr<Collider2D> &receiver, CollisionEventType eventType
     );
     /// Collision detection
-    void broadPhase(const std::vector<Engine::Ptr<Collider2D>> &collidersToChecks);
+    /// @param indices The indices of the active colliders to check against each other
+    void broadPhase(const std::vector<uint32_t> &indices);
+    /// Moves the leaves of the active colliders in the AABB tree, adding the ones that are not in it yet
+    void updateTree();
+    /// Collision detection using the AABB tree, each active collider is checked against the leaves it overlaps
+    void treeBroadPhase();
+    /// Removes every collider from the AABB tree
+    void clearTree();
+    /// Stores the contact pair of the given active colliders, whose bounds overlap, unless they can not collide
+    void addContactPair(uint32_t index1, uint32_t index2);
     /// Collision resolution
     void narrowPhase();
     /// Separates the given bodies using the given Minimum Translation Vector to make sure they are not contained in each other
@@ -85,6 +85,8 @@ namespace Engine2D::Physics {
       float inertiaInv;
       /// Accumulated force applied to the rigidbody.
       glm::vec2 force;
+      /// The last physics step during which this rigidbody was integrated
+      uint64_t lastStep;
 
       static constexpr float RECTANGLE_COLLISION_FACTOR = 1.0f / 12.0f;
 
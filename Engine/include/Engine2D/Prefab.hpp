@@ -0,0 +1,125 @@
+//
+// Prefab.hpp
+// Author: Antoine Bastide
+// Date: 16.10.2026
+//
+
+#ifndef PREFAB_HPP
+#define PREFAB_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Engine/Data/JSON.hpp"
+#include "Engine/Types/Ptr.hpp"
+
+namespace Engine2D {
+  class Scene;
+  class Entity2D;
+  class Component2D;
+
+  /**
+   * Template of an entity and of all its children that can be instantiated many times.
+   * The components are captured with the copy constructor of their type, so instantiating a prefab copies them directly
+   * instead of going through their serialized representation, types that can not be copied are serialized once when
+   * captured and loaded back for each instance.
+   * @note Pointers from a captured component to other entities or components are copied as is, they are not remapped to
+   * the matching entity or component of the instance
+   */
+  class Prefab final {
+    public:
+      /// Captures the given entity and all its children, changes made to them afterward do not affect the prefab
+      explicit Prefab(const Engine::Ptr<Entity2D> &entity);
+      ~Prefab();
+      Prefab(Prefab &&) noexcept;
+      Prefab &operator=(Prefab &&) noexcept;
+
+      /**
+       * Creates a copy of the captured entities in the active scene
+       * @param position The local position of the root of the copy
+       * @param rotation The local rotation of the root of the copy
+       * @param parent The parent of the root of the copy
+       * @return The root of the copy
+       */
+      Engine::Ptr<Entity2D> Instantiate(
+        glm::vec2 position = glm::vec2(0.0f, 0.0f), float rotation = 0.0f, const Engine::Ptr<Entity2D> &parent = {}
+      ) const;
+      /**
+       * Creates one copy of the captured entities in the active scene for each of the given positions, the storage of
+       * every copy is reserved up front and their components are registered with the scene systems in a single pass
+       * @param positions The local position of the root of each copy
+       * @param rotation The local rotation of the root of each copy
+       * @param parent The parent of the root of each copy
+       * @return The root of each copy, in the order of the given positions
+       */
+      std::vector<Engine::Ptr<Entity2D>> Instantiate(
+        const std::vector<glm::vec2> &positions, float rotation = 0.0f, const Engine::Ptr<Entity2D> &parent = {}
+      ) const;
+
+      /// @returns The name of the root of the captured entities
+      [[nodiscard]] const std::string &Name() const;
+      /// @returns The number of entities created by each instantiation
+      [[nodiscard]] size_t EntityCount() const;
+    private:
+      /// A captured component
+      struct Component final {
+        /// The copy of the component, not attached to any entity, null if its type can not be copied
+        std::unique_ptr<Component2D> copy;
+        /// The type of the component, only set if its type can not be copied
+        std::string type;
+        /// The serialized representation of the component, only set if its type can not be copied
+        Engine::JSON json;
+        /// The type id of the component
+        uint32_t typeId;
+        /// Whether the component is a behaviour
+        bool behaviour;
+      };
+
+      /// A captured entity
+      struct Node final {
+        /// The name of the entity
+        std::string name;
+        /// Whether the entity is active
+        bool active;
+        /// Whether the entity is static
+        bool isStatic;
+        /// The local position of the entity
+        glm::vec2 position;
+        /// The local rotation of the entity
+        float rotation;
+        /// The local scale of the entity
+        glm::vec2 scale;
+        /// The index of the node of the parent of the entity, nodes come after their parent, -1 for the root
+        int parent;
+        /// The components of the entity
+        std::vector<Component> components;
+        /// The number of components of the entity that are behaviours
+        size_t behaviourCount;
+        /// The highest type id of the components of the entity
+        uint32_t maxTypeId;
+      };
+
+      /// The captured entities in depth first order
+      std::vector<Node> nodes;
+      /// The number of components of each type id in the captured entities
+      std::vector<size_t> componentsPerType;
+
+      /// Captures the given entity and its children after the node of the given parent
+      void capture(const Entity2D *entity, int parent);
+      /// Creates a copy of the captured entities in the given scene, the components that need to be forwarded to the
+      /// scene systems are added to the given list instead of being forwarded
+      Entity2D *instantiate(
+        Scene *scene, glm::vec2 position, float rotation, const Engine::Ptr<Entity2D> &parent,
+        std::vector<Component2D *> &toForward
+      ) const;
+      /// Reserves the storage the scene needs to register the given number of copies
+      void reserve(Scene *scene, size_t count) const;
+
+      /// @returns A new component with the state of the given captured component, not attached to any entity
+      static std::unique_ptr<Component2D> clone(const Component &component);
+  };
+}
+
+#endif //PREFAB_HPP
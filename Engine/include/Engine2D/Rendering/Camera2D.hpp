@@ -25,8 +25,11 @@ namespace Engine {
 }
 
 namespace Engine2D::Rendering {
+  class Renderer2D;
+
   class Camera2D final : public Component2D, public Engine::Reflection::ICustomEditor {
     SERIALIZE_CAMERA2D
+      friend class Renderer2D;
       friend class Engine2D::Scene;
       friend class Engine2D::Game2D;
       friend class Engine2D::Entity2D;
@@ -63,8 +66,6 @@ namespace Engine2D::Rendering {
       /// Coefficients that control the shake of the camera on the Y axis
       std::vector<ShakeWave> shakeCoefficientsY;
 
-      ~Camera2D() override;
-
       /// Starts the camera shake effect
       void Shake(float duration);
       /// Checks if the sprite is visible to the camera
@@ -91,16 +92,12 @@ namespace Engine2D::Rendering {
       glm::mat4 view;
       /// The combined view-projection matrix used to transform world coordinates into clip space.
       glm::mat4 viewProjection;
-      /// Whether the camera is initialized or not
-      bool initialized;
       /// If the camera is currently shaking
       bool shaking;
       /// How long the camera should shake for
       ENGINE_SERIALIZE float shakeDuration;
       /// How long the camera has been shaking for
       float shakeElapsed;
-      /// UBO used to send data to all shaders
-      uint ubo;
       /// The index of the entity in the entities vector the camera is following
       int followTargetIndex;
       /// The velocity of the follow camera velocity
@@ -118,7 +115,7 @@ namespace Engine2D::Rendering {
       Camera2D();
       Camera2D(float left, float right, float bottom, float top);
 
-      void initialize();
+      /// Updates the camera's matrices, they are sent to the GPU by the renderer
       void updateCamera();
       glm::vec2 getCameraShake(float frac) const;
 
@@ -0,0 +1,66 @@
+//
+// FrameSnapshot.hpp
+// Author: Antoine Bastide
+// Date: 16.10.2026
+//
+
+#ifndef FRAME_SNAPSHOT_HPP
+#define FRAME_SNAPSHOT_HPP
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace Engine2D {
+  class Scene;
+}
+
+namespace Engine2D::Rendering {
+  /// Draw range of a batch: shader id, texture id, first instance, instance count, blend mode and texture index
+  using Flush = std::tuple<uint32_t, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t>;
+
+  /**
+   * Copy of everything the renderer needs to draw a frame. It is extracted from the scene on the update thread and is
+   * then only read by the render thread, so that the next frame can be updated while this one is being drawn.
+   */
+  struct FrameSnapshot final {
+    /// The instance data of a batch and how to draw it
+    struct Batch final {
+      /// The per instance data sent to the GPU
+      std::vector<float> data;
+      /// Tells the renderer how to draw the instance data
+      std::vector<Flush> flushList;
+      /// Incremented each time the data changes, used to only copy static batches when they change
+      uint64_t version = 0;
+    };
+
+    /// The scene the snapshot was extracted from and whose renderer draws it, scenes are only destroyed once the render
+    /// thread is done with the snapshot it was given, see Game2D::waitForRenderedFrame
+    Scene *scene = nullptr;
+    /// The telemetry frame the snapshot was extracted in, the time spent drawing it is added to that frame
+    uint64_t frame = 0;
+    /// Whether the scene had no entities when the snapshot was extracted, in which case nothing is presented
+    bool empty = true;
+    /// Whether the main camera was active when the snapshot was extracted, in which case the batches are drawn
+    bool cameraActive = false;
+
+    /// The view matrix of the main camera
+    glm::mat4 view{1.0f};
+    /// The projection matrix of the main camera
+    glm::mat4 projection{1.0f};
+    /// The view projection matrix of the main camera
+    glm::mat4 viewProjection{1.0f};
+
+    /// The static opaque sprites
+    Batch staticOpaque;
+    /// The opaque sprites and particles
+    Batch opaque;
+    /// The static transparent sprites
+    Batch staticTransparent;
+    /// The transparent sprites and particles
+    Batch transparent;
+  };
+}
+
+#endif //FRAME_SNAPSHOT_HPP
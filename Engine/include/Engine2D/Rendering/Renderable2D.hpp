@@ -18,7 +18,9 @@ namespace Engine::Rendering {
 
 namespace Engine2D {
   class Scene;
+  class SceneResources;
   class Transform2D;
+  class WorldStreamer;
 }
 
 namespace Engine2D::Rendering {
@@ -28,7 +30,9 @@ namespace Engine2D::Rendering {
     SERIALIZE_RENDERABLE2D
       friend class Renderer2D;
       friend class Engine2D::Scene;
+      friend class Engine2D::SceneResources;
       friend class Engine2D::Transform2D;
+      friend class Engine2D::WorldStreamer;
     public:
       enum RenderableType {
         None, SpriteRenderer, ParticleSystem
@@ -61,9 +65,19 @@ namespace Engine2D::Rendering {
       ENGINE_SHOW_IN_INSPECTOR Rendering::Sprite *sprite;
       /// Whether the sprite renderer was updated
       bool dirty;
+      /// The version of the transform of the entity the data of this renderable was last extracted for
+      uint32_t transformVersion;
+      /// The index of this renderable in the list of renderables of the resources of its scene
+      size_t resourceIndex;
+      /// The static batch this renderable is drawn in if its entity is static, the id of the streamed chunk it was
+      /// loaded from or 0 if it is not part of one
+      uint32_t staticGroup;
 
       Renderable2D();
       explicit Renderable2D(RenderableType type);
+      /// Copies the settings of the given renderable, the copy is extracted on its own and is not part of any static
+      /// group
+      Renderable2D(const Renderable2D &other);
 
       void OnSerialize(Engine::Reflection::Format format, Engine::JSON &json) const override;
       void OnDeserialize(Engine::Reflection::Format format, const Engine::JSON &json) override;
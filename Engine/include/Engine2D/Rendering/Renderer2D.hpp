@@ -7,9 +7,11 @@
 #ifndef SPRITE_RENDERER_H
 #define SPRITE_RENDERER_H
 
+#include <map>
 #include <unordered_set>
 
 #include "Engine2D/ParticleSystem/ParticleSystem2D.hpp"
+#include "Engine2D/Rendering/FrameSnapshot.hpp"
 
 namespace Engine {
   class ResourceManager;
@@ -34,8 +36,6 @@ namespace Engine2D::Rendering {
   class SpriteRenderer;
   class Renderable2D;
 
-  using Flush = std::tuple<uint32_t, uint32_t, uint32_t, uint32_t, uint32_t>;
-
   /// Class responsible for rendering all the textures/sprites in the game
   class Renderer2D {
     friend class SpriteRenderer;
@@ -61,10 +61,20 @@ namespace Engine2D::Rendering {
       std::vector<SpriteRenderer *> opaqueRenderers;
       /// All the sprite renderers in the scene that are transparent
       std::vector<SpriteRenderer *> transparentRenderers;
-      /// All the static sprite renderers in the scene that are opaque
-      std::vector<SpriteRenderer *> staticOpaqueRenderers;
-      /// All the static sprite renderers in the scene that are transparent
-      std::vector<SpriteRenderer *> staticTransparentRenderers;
+      /// Static sprite renderers that are batched together, a streamed chunk is added and removed as a whole
+      struct StaticGroup final {
+        /// The renderers of the group
+        std::vector<SpriteRenderer *> renderers;
+        /// The data of the renderers of the group
+        FrameSnapshot::Batch batch;
+        /// Whether renderers were added to or removed from the group since its batch was built
+        bool changed = true;
+      };
+
+      /// The static sprite renderers in the scene that are opaque, by static group
+      std::map<uint32_t, StaticGroup> staticOpaqueGroups;
+      /// The static sprite renderers in the scene that are transparent, by static group
+      std::map<uint32_t, StaticGroup> staticTransparentGroups;
 
       /// The renderers that are pending to be added but do not have a sprite or a texture
       std::vector<SpriteRenderer *> invalidRenderers;
@@ -87,6 +97,8 @@ namespace Engine2D::Rendering {
       uint staticOpaqueBatchVBO;
       /// Vertex buffer object used for batching static transparent renderers
       uint staticTransparentBatchVBO;
+      /// Uniform buffer object used to send the camera matrices to all the shaders
+      uint cameraUBO;
       /// The id of the previously drawn texture
       uint lastBoundTexture;
 
@@ -94,23 +106,17 @@ namespace Engine2D::Rendering {
       uint instanceCount;
       /// The last shader that was used
       uint lastShaderID;
-      /// The number of static opaque sprites during the previous pass
-      size_t lastOpaqueStaticCount;
-      /// The number of static transparent sprites during the previous pass
-      size_t lastTransparentStaticCount;
-
-      /// Data linked to all the static renderers in the scene for opaque sprites
-      std::vector<float> staticOpaqueBatchData;
-      /// Data linked to all the static renderers in the scene for transparent sprites
-      std::vector<float> staticTransparentBatchData;
-      /// Tells the renderer how to use the static batch data for opaque sprites
-      std::vector<Flush> staticOpaqueFlushList;
-      /// Tells the renderer how to use the static batch data for transparent sprites
-      std::vector<Flush> staticTransparentFlushList;
-      /// Tells the renderer how to use the static batch data for opaque sprites
-      std::vector<Flush> opaqueFlushList;
-      /// Tells the renderer how to use the static batch data for transparent sprites
-      std::vector<Flush> transparentFlushList;
+
+      /// Data linked to all the static renderers in the scene for opaque sprites, the batches of the groups one after
+      /// the other
+      FrameSnapshot::Batch staticOpaqueBatch;
+      /// Data linked to all the static renderers in the scene for transparent sprites, the batches of the groups one
+      /// after the other
+      FrameSnapshot::Batch staticTransparentBatch;
+      /// The renderers of the batch being built, with their offset in the batch and the index of their texture
+      std::vector<std::tuple<Renderable2D *, uint32_t, uint>> batchEntries;
+      /// The snapshot used when the frame is extracted and drawn on the same thread
+      FrameSnapshot immediateSnapshot;
       /// The scene this renderer is a part of
       Scene *scene;
 
@@ -132,25 +138,35 @@ namespace Engine2D::Rendering {
       static bool cannotBeRendered(const Renderable2D *r);
       /// Returns true if a needs to be before b, False if not
       bool sortRenderers(const Renderable2D *a, const Renderable2D *b) const;
-      /// Extracts all the data needed to render the sprite renderer
-      void extractRendererData(const SpriteRenderer *renderer, float *data) const;
-      /// Maps the given id to an index to be used in the shader
-      void mapTextureIdToIndex(const uint &textureId);
-
-      /// Builds and renders the given batch
-      void buildAndRenderStaticBatch(
-        std::vector<SpriteRenderer *> &renderers, std::vector<float> &batchData,
-        std::vector<Flush> &flushList, bool rebuild, uint VBO, uint framebuffer = 0
+      /// Extracts all the data needed to render the sprite renderer, interpolating its transform if it was moved by the
+      /// given physics step
+      static void extractRendererData(
+        const SpriteRenderer *renderer, float *data, uint textureIndex, float interpolation = 1.0f,
+        uint64_t physicsStep = 0
       );
+      /// Extracts the data of all the batch entries to the given buffer in parallel
+      void extractBatchData(float *data);
+      /// Maps the given id to an index to be used in the shader
+      /// @returns The index of the texture in the shader
+      uint mapTextureIdToIndex(uint textureId);
+
+      /// Builds the given static batch if needed and updates the data of its dirty renderers
+      void buildStaticBatch(std::vector<SpriteRenderer *> &renderers, FrameSnapshot::Batch &batch, bool rebuild);
+      /**
+       * Builds the groups that changed, updates the data of the dirty renderers of the others and joins them in the
+       * given batch, so that loading or unloading a streamed chunk does not rebuild the batches of the other chunks
+       * @note Static transparent sprites are only sorted against the sprites of their own group
+       */
+      void buildStaticGroups(std::map<uint32_t, StaticGroup> &groups, FrameSnapshot::Batch &batch);
       /// Updates the data linked to the stored static sprites
-      void updateBatch(
-        const std::vector<SpriteRenderer *> &renderers, std::vector<float> &staticBatchData
-      ) const;
-      /// Builds and renders the given batch
-      void buildAndRenderBatch(
-        std::vector<Renderable2D *> &renderers, std::vector<Flush> &flushList, uint particleCount, bool resort,
-        uint framebuffer = 0
+      /// @returns True if the data of any renderer was updated
+      bool updateBatch(const std::vector<SpriteRenderer *> &renderers, std::vector<float> &staticBatchData) const;
+      /// Builds the given batch using the given renderers
+      void buildBatch(
+        std::vector<Renderable2D *> &renderers, FrameSnapshot::Batch &batch, uint particleCount, bool resort
       );
+      /// Draws the given batch
+      void renderBatch(const FrameSnapshot::Batch &batch, uint VBO, int drawMode, uint framebuffer = 0);
       /// Changes the blend mode of the flush list
       static void setBlendMode(
         bool opaque, bool isParticle, ParticleSystem2D::BlendMode blendMode = ParticleSystem2D::BlendMode::Alpha
@@ -162,12 +178,16 @@ namespace Engine2D::Rendering {
       void initRenderData();
       /// Partitions the sprites for easier rendering
       void updateAndSplitRenderList();
-      /// Renders all the opaque sprites
-      void opaquePass(uint framebuffer = 0);
-      /// Renders all the transparent sprites
-      void transparentPass(uint framebuffer = 0);
-
-      /// Renders all sprites
+      /// Extracts all the opaque sprites to the given snapshot
+      void opaquePass(FrameSnapshot &snapshot);
+      /// Extracts all the transparent sprites to the given snapshot
+      void transparentPass(FrameSnapshot &snapshot);
+
+      /// Extracts all the data needed to render the scene to the given snapshot, does not make any GPU call
+      void extract(FrameSnapshot &snapshot);
+      /// Draws the given snapshot, must be called on the thread that owns the GL context
+      void submit(const FrameSnapshot &snapshot, uint framebuffer = 0);
+      /// Extracts and draws all sprites
       void render(uint framebuffer = 0);
 
       /// Adds a new sprite renderer to the list of ones to be rendered
@@ -7,8 +7,15 @@
 #ifndef SCENE_HPP
 #define SCENE_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
+#include "Engine/Settings.hpp"
 #include "Engine/Types/Ptr.hpp"
 #include "Engine2D/Entity2D.hpp"
 #include "Engine2D/Animation/AnimationSystem.hpp"
@@ -16,6 +23,7 @@
 #include "Engine2D/Physics/Physics2D.hpp"
 #include "Engine2D/Rendering/Renderer2D.hpp"
 #include "Engine2D/SceneManagement/SceneResources.hpp"
+#include "Engine2D/SceneManagement/WorldStreamer.hpp"
 #include "Scene.gen.hpp"
 
 namespace Editor {
@@ -49,18 +57,23 @@ namespace Engine2D {
 
   namespace Physics {
     class Collider2D;
+    class Physics2D;
   }
 
   class Scene final : public Engine::Reflection::Reflectable {
     SERIALIZE_SCENE
       friend class Game2D;
       friend class Entity2D;
+      friend class Prefab;
+      friend class Component2D;
       friend class Transform2D;
       friend class SceneManager;
+      friend class WorldStreamer;
       friend class Editor::Window;
       friend class Engine::Settings;
       friend class ParticleSystem2D;
       friend class Physics::Collider2D;
+      friend class Physics::Physics2D;
       friend class Rendering::Camera2D;
       friend class Animation::Animator2D;
       friend class Rendering::Renderer2D;
@@ -82,30 +95,44 @@ namespace Engine2D {
       /// @returns A pointer to the main camera of this scene
       [[nodiscard]] Engine::Ptr<Rendering::Camera2D> MainCamera() const;
 
+      /// @returns The streamer that loads and unloads the chunks of the world of this scene around the main camera
+      [[nodiscard]] WorldStreamer &Streamer();
+
       /// @returns The entity with the given name if it was found, nullptr if not
       Engine::Ptr<Entity2D> Find(const std::string &name) const;
 
       template<typename T> requires std::is_base_of_v<Component2D, T>
-      /// @returns The first entity with the given component, nullptr if no entity is found
+      /// @returns The first component of the given type in this scene, nullptr if none is found
       Engine::Ptr<T> FindObjectOfType() const {
         if constexpr (std::is_same_v<Transform2D, T>)
-          return entities.front()->Transform();
-
-        for (const auto &entity: entities)
-          if (T *component = nullptr; !entity->destroyed && entity->TryGetComponent<T>(&component))
-            return component;
-
-        return nullptr;
+          return entities.empty() ? nullptr : entities.front()->Transform();
+        else {
+          Engine::Ptr<T> result;
+          forEachComponentOfType<T>(
+            [&result](T *component) {
+              result = component;
+              return false;
+            }
+          );
+          return result;
+        }
       }
 
       template<typename T> requires std::is_base_of_v<Component2D, T>
-      /// @returns All the entities with the given component, nullptr if no entities are found
+      /// @returns All the components of the given type in this scene
       std::vector<Engine::Ptr<T>> FindObjectsOfType() const {
         std::vector<Engine::Ptr<T>> res;
-        for (const auto &entity: entities)
-          if (T *component = nullptr; !entity->destroyed && entity->TryGetComponent<T>(&component))
-            res.emplace_back(component);
-
+        if constexpr (std::is_same_v<Transform2D, T>) {
+          for (const auto &entity: entities)
+            if (!entity->destroyed)
+              res.emplace_back(entity->Transform());
+        } else
+          forEachComponentOfType<T>(
+            [&res](T *component) {
+              res.emplace_back(component);
+              return true;
+            }
+          );
         return res;
       }
 
@@ -117,6 +144,19 @@ namespace Engine2D {
       ENGINE_SERIALIZE std::vector<std::unique_ptr<Entity2D>> entities;
       /// The name of this scene
       std::string name;
+      /// The components of the entities of this scene grouped by type, indexed by component type id, removed ones are
+      /// left as null until the next sync
+      std::vector<std::vector<Component2D *>> componentsByType;
+      /// The entities of this scene grouped by name, pending ones included, in the order they were named, removed ones
+      /// are left as null until the next sync
+      std::unordered_map<std::string, std::vector<Entity2D *>> entitiesByName;
+      /// The names whose list of entities has holes to compact during the next sync
+      std::unordered_set<std::string> namesToCompact;
+      /// Guards the entities by name and the names to compact, parallel behaviours can rename their own entity while
+      /// others look entities up by name
+      mutable std::shared_mutex namesMutex;
+      /// The component type ids whose list of components has holes to compact during the next sync
+      std::unordered_set<uint32_t> typesToCompact;
       /// The main camera of the game
       Engine::Ptr<Rendering::Camera2D> cameraComponent;
       /// If the scene has been initialized
@@ -131,15 +171,67 @@ namespace Engine2D {
       #endif
       /// Entities scheduled to be removed from the game
       std::unordered_set<Engine::Ptr<Entity2D>> entitiesToRemove;
-      #if MULTI_THREAD
-      /// Entities that should be removed from memory
+      /// Entities that should be removed from memory, only used when the game is rendered on its own thread
       std::unordered_set<Engine::Ptr<Entity2D>> entitiesToDestroy;
-      #endif
+      /// Entities of this scene with behaviours waiting for their first update, in the order they were queued
+      std::vector<Entity2D *> entitiesToInitialize;
+      /// Destroyed entities that are still in memory, counting down their time to live
+      std::unordered_set<Entity2D *> entitiesToExpire;
+
+      /// The active behaviours overriding OnUpdate that only read the scene, in entity order, activated ones are
+      /// appended since these behaviours run in parallel
+      std::vector<Engine::Ptr<Behaviour>> readOnlyUpdates;
+      /// The active behaviours overriding OnUpdate that only access their own entity, grouped by hierarchy
+      std::vector<Engine::Ptr<Behaviour>> ownEntityUpdates;
+      /// The index of the first behaviour of each hierarchy in ownEntityUpdates, followed by the size of the list
+      std::vector<size_t> hierarchyOffsets;
+      /// The root of each hierarchy in ownEntityUpdates, mapped to the index of its range in hierarchyOffsets
+      std::unordered_map<const Entity2D *, size_t> hierarchyRanges;
+      /// The active behaviours overriding OnUpdate that might write shared state, in entity order
+      std::vector<Engine::Ptr<Behaviour>> sharedUpdates;
+      /// The active behaviours overriding OnFixedUpdate, in entity order
+      std::vector<Engine::Ptr<Behaviour>> fixedUpdates;
+      /// Whether behaviours, entities or hierarchies were added or removed since the dispatch lists were built, atomic
+      /// since parallel behaviours can change the hierarchy of their own entity from a worker thread
+      std::atomic<bool> dispatchListsDirty;
+      /// The entities activated since the dispatch lists were built, their behaviours are added before the next update
+      std::vector<Entity2D *> activatedEntities;
+      /// The behaviours activated since the dispatch lists were built, they are added before the next update
+      std::vector<Behaviour *> activatedBehaviours;
+      /// Guards the activated entities and behaviours, parallel behaviours can activate their own entity
+      std::mutex activationMutex;
+
+      /// A transform in the flattened hierarchies of the scene
+      struct TransformNode final {
+        Transform2D *transform;
+        /// The index of the node of the parent of the transform, -1 for the roots
+        int32_t parent;
+      };
+      /// The transforms of the entities of this scene, each hierarchy is stored contiguously with parents before their
+      /// children, so the descendants of a transform are the nodes that follow it up to its hierarchy end
+      std::vector<TransformNode> transformNodes;
+      /// The index of the first node of each hierarchy in transformNodes, followed by the number of nodes
+      std::vector<size_t> transformHierarchyOffsets;
+      /// Whether the world values of each node were changed by the current propagation pass, in the order of the nodes
+      std::vector<uint8_t> transformsUpdated;
+      /// Whether a transform was moved since the last propagation pass, atomic since parallel behaviours can move their
+      /// own entity from a worker thread
+      std::atomic<bool> transformsDirty;
+      /// Whether entities or hierarchies changed since the transform nodes were built
+      std::atomic<bool> transformOrderDirty;
+
+      /// The time step of the current tick when this scene is stepped on its own thread
+      float deltaTime;
+      /// The time not yet simulated by the physics engine
+      float physicsAccumulator;
+      /// The physics settings of this scene
+      Engine::Settings::Physics::Values physicsSettings;
 
       Physics::Physics2D physicsSystem;
       Rendering::Renderer2D renderingSystem;
       Animation::AnimationSystem animationSystem;
       ParticleSystemRegistry2D particleSystemRegistry;
+      WorldStreamer streamer;
 
       Scene();
       explicit Scene(const std::string &name);
@@ -151,19 +243,101 @@ namespace Engine2D {
       /// Removes an entity from the game
       void removeEntity(const Engine::Ptr<Entity2D> &entity);
 
+      /// Adds the given entity to the entities with its name
+      void indexName(Entity2D *entity);
+      /// Removes the given entity from the entities with the name it was indexed under
+      void unindexName(Entity2D *entity);
+      /// Renames the given entity and moves it to the entities with its new name, as a single step for the threads
+      /// looking entities up by name
+      void renameEntity(Entity2D *entity, const std::string &name);
+      /// Adds the given entity to the entities with its name, the names mutex must be held
+      void addToNameIndex(Entity2D *entity);
+      /// Removes the given entity from the entities with its indexed name, the names mutex must be held
+      void removeFromNameIndex(const Entity2D *entity);
+      /// Adds the given entity and all its components to the indexes of this scene
+      void indexEntity(Entity2D *entity);
+      /// Removes the given entity and all its components from the indexes of this scene
+      void unindexEntity(Entity2D *entity);
+      /// Adds the given component to the components of its type
+      void registerComponent(Component2D *component);
+      /// Removes the given component from the components of its type
+      void unregisterComponent(Component2D *component);
+      /// Removes the holes left in the indexes by the entities and components removed since the last sync
+      void compactIndexes();
+
+      template<typename T>
+      /// Calls the given function on each component of the given type whose entity is not destroyed, until it returns
+      /// false
+      void forEachComponentOfType(const std::function<bool(T *)> &function) const {
+        const auto visit = [&](const std::vector<Component2D *> &components) {
+          for (const auto component: components)
+            if (component && !component->entity->destroyed && !function(static_cast<T *>(component)))
+              return false;
+          return true;
+        };
+
+        if constexpr (std::is_final_v<T>) {
+          if (const uint32_t typeId = ComponentType::Id<T>(); typeId < componentsByType.size())
+            visit(componentsByType[typeId]);
+        } else {
+          // All the components of a list share the same type, so only the first one needs to be cast
+          for (const auto &components: componentsByType) {
+            const auto first = std::ranges::find_if(
+              components, [](const Component2D *component) {
+                return component != nullptr;
+              }
+            );
+            if (first != components.end() && dynamic_cast<T *>(*first) && !visit(components))
+              return;
+          }
+        }
+      }
+
       /// Initializes the scene
       void initialize();
+      /// Binds the input of the behaviours of a scene that was just loaded, input is global so this is not done while
+      /// deserializing since scenes can be deserialized on a background thread
+      void bindInput() const;
       /// Updates all the entities in this scene
-      #if MULTI_THREAD
       void update();
-      #else
-      void update() const;
-      #endif
+      /// Rebuilds the lists of behaviours to call for each hook if entities or hierarchies changed since they were last
+      /// built, otherwise only adds the behaviours activated since then
+      void buildDispatchLists();
+      /// Adds the own entity behaviours of the given entity and of all its children to the dispatch lists
+      void addHierarchyToDispatchLists(const Entity2D *entity);
+      /// Queues the behaviours of the given entity and of its children to be added to the dispatch lists
+      void queueActivation(Entity2D *entity);
+      /// Queues the given behaviour to be added to the dispatch lists
+      void queueActivation(Behaviour *behaviour);
+      /// Adds the given behaviour to the dispatch lists if it is active and not in them yet, own entity behaviours are
+      /// added to the range of their hierarchy
+      /// @returns False if the behaviour is a shared or fixed one, which only a rebuild can place in entity order
+      bool addToDispatchLists(Behaviour *behaviour);
+      /// Adds the behaviours of the given entity and of its active children to the dispatch lists
+      /// @returns False if one of them has to be placed by a rebuild, see addToDispatchLists
+      bool addEntityToDispatchLists(const Entity2D *entity);
+      /// Removes the given entity and its behaviours from the entities and behaviours waiting to be dispatched
+      void purgeActivations(const Entity2D *entity);
+      /// Clears the given behaviour from the dispatch lists, they are compacted during the next rebuild
+      void removeFromDispatchLists(const Engine::Ptr<Behaviour> &behaviour);
+      /// Recomputes the world values of the transforms moved since the last pass and of their children, each hierarchy
+      /// is updated from its root down and separate hierarchies are updated in parallel
+      /// @param physicsStep The physics step that moved the transforms, the descendants of the bodies it integrated
+      /// keep their previous world values so that they are rendered interpolated along with them, 0 outside of a step
+      void propagateTransforms(uint64_t physicsStep = 0);
+      /// Rebuilds the flattened hierarchies if entities or hierarchies changed since they were built
+      void buildTransformNodes();
+      /// Adds the transform of the given entity and of all its children to the flattened hierarchies
+      void addHierarchyToTransformNodes(const Entity2D *entity, int32_t parent);
       /// Call the physics step for all the entities in this scene
       void fixedUpdate();
       /// Animates all entities
-      void animate() const;
-      /// Renders all the entities in this scene
+      void animate();
+      /// Extracts the data needed to render this scene to the given snapshot, does not make any GPU call
+      void extractFrame(Rendering::FrameSnapshot &snapshot);
+      /// Renders the given snapshot of this scene and presents it
+      void render(const Rendering::FrameSnapshot &snapshot);
+      /// Extracts and renders all the entities in this scene
       void render();
       /// Renders the scene in headless mode
       void renderHeadless();
@@ -7,9 +7,13 @@
 #ifndef SCENE_MANAGER_HPP
 #define SCENE_MANAGER_HPP
 
+#include <atomic>
+#include <future>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
+#include "Engine/Threading/JobSystem.hpp"
 #include "Engine/Types/Ptr.hpp"
 #include "Engine2D/SceneManagement/Scene.hpp"
 
@@ -18,6 +22,7 @@ namespace Editor {
 }
 
 namespace Engine {
+  class Settings;
   class ResourceManager;
 }
 
@@ -25,8 +30,25 @@ namespace Engine2D {
   class SceneManager final {
     friend class Game2D;
     friend class Editor::SceneHierarchy;
+    friend class Engine::Settings;
     friend class Engine::ResourceManager;
     public:
+      /**
+       * Makes the given scene the active scene of the calling thread and of the jobs it schedules until it goes out of
+       * scope, the active scene of the other threads is left untouched.
+       * Used to step several scenes at the same time, each on its own thread.
+       */
+      class ScopedScene final {
+        public:
+          explicit ScopedScene(const Engine::Ptr<Scene> &scene);
+          ~ScopedScene();
+          ScopedScene(const ScopedScene &) = delete;
+          ScopedScene &operator=(const ScopedScene &) = delete;
+        private:
+          /// The context of the calling thread before this scope
+          void *previous;
+      };
+
       /// Create's a new scene with the given name
       /// @param name The name of the new scene
       /// @note Returns null if a scene with the given name already exists
@@ -36,10 +58,24 @@ namespace Engine2D {
       /// Load's the scene with the given name into memory
       /// @param name The name of the scene to load
       /// @param path The file in which the scene to load is stored
-      /// @note If a scene with the given name already exists, it will be overridden
-      /// @returns A pointer to the loaded scene
+      /// @note If a scene with the given name already exists, it will be overridden once the render thread is done
+      /// drawing its last frame
+      /// @returns A pointer to the loaded scene, nullptr if the scene could not be loaded
       static Engine::Ptr<Scene> LoadScene(const std::string &name, const std::string &path);
 
+      /// Load's the scene with the given name into memory on a background thread, the file is read and parsed and the
+      /// entities are created without blocking the game, the resources of the scene are then uploaded to the GPU in
+      /// slices between the next frames, see Settings::Graphics::SetRenderCommandBudget
+      /// @param name The name of the scene to load
+      /// @param path The file in which the scene to load is stored
+      /// @note If a scene with the given name already exists, it will be overridden once the new one is loaded
+      /// @note The scene is added between two frames, waiting on the future from the update thread blocks forever
+      /// @returns A future that holds a pointer to the loaded scene once it has been added, or the reason it could not
+      /// be loaded
+      static std::future<Engine::Ptr<Scene>> LoadSceneAsync(const std::string &name, const std::string &path);
+      /// @returns True if scenes are being loaded in the background, false if not
+      [[nodiscard]] static bool IsLoading();
+
       /// Save's the scene with the given name into the given file
       /// @param name The name of the scene to save
       /// @param path The file in which to save the scene
@@ -78,6 +114,7 @@ namespace Engine2D {
 
       /// Remove's the scene with the given name, all it's entities and their components from memory
       /// @param name The name of the scene to destroy
+      /// @note With a render thread, waits for it to finish drawing the frame extracted from the scene
       static void DestroyScene(const std::string &name);
 
       /// Remove's all the scene from the game, all their entities and their components from memory
@@ -90,7 +127,7 @@ namespace Engine2D {
       /// @note If no scene with the given name exist, the active scene will be set to null
       static void SetActiveScene(const std::string &name);
 
-      /// @returns A pointer to the currently loaded scene
+      /// @returns A pointer to the currently loaded scene, or to the scene stepped by the calling thread if any
       static Engine::Ptr<Scene> ActiveScene();
 
       /// @returns A pointer to the scene with the given name, nullptr if no scene is found
@@ -98,8 +135,30 @@ namespace Engine2D {
     private:
       /// All the created or loaded scenes in the game
       inline static std::unordered_map<std::string, std::unique_ptr<Scene>> scenes;
-      /// The scene currently displayed
-      inline static Engine::Ptr<Scene> activeScene;
+      /// The scene currently displayed, atomic since it is read by the threads loading and rendering scenes
+      inline static std::atomic<Scene *> activeScene;
+
+      /// A scene being loaded on a background thread
+      struct PendingLoad final {
+        /// The name the scene is added under once it is loaded
+        std::string name;
+        /// The scene being read, parsed and created on the background thread
+        std::future<std::unique_ptr<Scene>> scene;
+        /// Holds the added scene once it has been added
+        std::promise<Engine::Ptr<Scene>> loaded;
+      };
+      /// The scenes being loaded in the background, in the order they were requested, only used by the update thread
+      inline static std::vector<PendingLoad> pendingLoads;
+
+      /// @returns The scene stored in the given file, its resources are queued to be uploaded to the GPU
+      static std::unique_ptr<Scene> readScene(const std::string &path);
+      /// Adds the given loaded scene under the given name, overriding the scene with that name if there is one
+      /// @returns A pointer to the added scene
+      static Engine::Ptr<Scene> addLoadedScene(const std::string &name, std::unique_ptr<Scene> scene);
+      /// Adds the scenes that finished loading in the background, called by the update thread between two frames
+      static void commitLoadedScenes();
+      /// @returns The scene stepped by the calling thread, nullptr if it steps the active scene
+      static Scene *steppedScene();
 
       /// Internal call to get the scene unique pointer
       /// @note Does not check if a scene with the given name exists
@@ -56,6 +56,7 @@ namespace Engine2D {
   class SceneResources final : public Engine::Reflection::Reflectable {
     SERIALIZE_SCENERESOURCES
       friend class Scene;
+      friend class WorldStreamer;
       friend class Rendering::Renderer2D;
       friend class Engine::ResourceManager;
       friend class ParticleSystemRegistry2D;
@@ -64,6 +65,11 @@ namespace Engine2D {
       void OnDeserialize(Engine::Reflection::Format format, const Engine::JSON &json) override;
     private:
       std::vector<Rendering::Renderable2D *> renderables;
+
+      /// Adds the given renderable to the ones whose resources are saved with the scene
+      void addRenderable(Rendering::Renderable2D *renderable);
+      /// Removes the given renderable from the ones whose resources are saved with the scene
+      void removeRenderable(Rendering::Renderable2D *renderable);
   };
 } // Engine2D
 
@@ -0,0 +1,189 @@
+//
+// WorldStreamer.hpp
+// Author: Antoine Bastide
+// Date: 16.10.2026
+//
+
+#ifndef WORLD_STREAMER_HPP
+#define WORLD_STREAMER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Engine/Data/JSON.hpp"
+#include "Engine/Types/Handle.hpp"
+#include "Engine/Types/Ptr.hpp"
+#include "Engine2D/Entity2D.hpp"
+
+namespace Engine2D {
+  class Scene;
+
+  /**
+   * Splits the world of a scene into square chunks that are each saved to their own file, the chunks around the main
+   * camera are loaded on a background thread and added to the scene between frames, and the ones that get too far are
+   * unloaded or deactivated.
+   * Each chunk is added to and removed from the scene as a whole, its static sprites are batched on their own so that
+   * streaming a chunk never rebuilds the static batches of the others.
+   * @note Chunks are loaded back from their file, changes made to their entities while they were loaded are lost
+   */
+  class WorldStreamer final {
+    friend class Scene;
+    public:
+      /// What happens to the chunks that leave the unload radius
+      enum class UnloadMode {
+        /// The entities of the chunk are destroyed and loaded back from the chunk file when the chunk is needed again
+        Destroy,
+        /// The entities of the chunk are deactivated and kept in memory until the chunk is needed again
+        Deactivate
+      };
+
+      ~WorldStreamer();
+      WorldStreamer(const WorldStreamer &) = delete;
+      WorldStreamer &operator=(const WorldStreamer &) = delete;
+
+      /// Starts streaming the chunks saved in the given directory around the main camera of the scene
+      void Enable(const std::string &directory);
+      /// Stops streaming, the chunks that are loaded stay in the scene
+      void Disable();
+
+      /**
+       * Saves the given entities and their children to the chunk files of the given directory, each entity goes to the
+       * chunk its world position is in, with the resources its sprites use
+       * @param directory The directory to save the chunk files in, created if it does not exist
+       * @param roots The entities to save, if empty every entity without a parent is saved except the main camera
+       * @note The saved entities are not removed from the scene
+       */
+      void SaveChunks(const std::string &directory, const std::vector<Engine::Ptr<Entity2D>> &roots = {}) const;
+
+      /// Sets the size of the side of a chunk in world units, only used when chunks are saved or streaming is enabled
+      void SetChunkSize(float size);
+      /// Sets the distance in chunks around the chunk of the camera within which chunks are loaded
+      void SetLoadRadius(int radius);
+      /// Sets the distance in chunks around the chunk of the camera past which chunks are unloaded, at least the load
+      /// radius so that chunks on the border are not loaded and unloaded back and forth
+      void SetUnloadRadius(int radius);
+      /// Sets what happens to the chunks that leave the unload radius
+      void SetUnloadMode(UnloadMode mode);
+      /// Sets the maximum number of chunks kept in memory, deactivated ones included, the farthest chunks outside the
+      /// load radius are unloaded first when there are more, 0 for no limit
+      void SetMaxLoadedChunks(size_t count);
+      /// Sets the maximum number of chunks read from disk at the same time
+      void SetMaxConcurrentLoads(size_t count);
+      /// Sets the maximum time in milliseconds spent adding loaded entities to the scene each frame, at least one
+      /// entity is added per frame, if set to 0 every loaded chunk is added at once
+      void SetCommitBudget(float milliseconds);
+
+      /// @returns The coordinates of the chunk the given world position is in
+      [[nodiscard]] glm::ivec2 ChunkOf(glm::vec2 position) const;
+      /// @returns True if the entities of the given chunk are in the scene and active, false if not
+      [[nodiscard]] bool IsLoaded(glm::ivec2 chunk) const;
+      /// @returns The number of chunks in memory, loading and deactivated ones included
+      [[nodiscard]] size_t LoadedChunkCount() const;
+      /// @returns True if chunks are streamed around the main camera, false if not
+      [[nodiscard]] bool Enabled() const;
+    private:
+      /// The state of a chunk
+      enum class State {
+        /// The chunk file is being read on a background thread
+        Loading,
+        /// The entities of the chunk are being added to the scene
+        Adding,
+        /// The entities of the chunk are in the scene and active
+        Loaded,
+        /// The entities of the chunk are in the scene but deactivated
+        Inactive
+      };
+
+      /// The content of a chunk file, read on a background thread
+      struct ChunkData final {
+        /// The entities of the chunk, not added to any scene yet, parents come before their children
+        std::vector<std::unique_ptr<Entity2D>> entities;
+        /// The serialized entities of the chunk, in the same order
+        Engine::JSON json;
+      };
+
+      /// A chunk in memory
+      struct Chunk final {
+        /// The state of the chunk
+        State state = State::Loading;
+        /// The static group of the sprites of the chunk
+        uint32_t group = 0;
+        /// The content of the chunk file while it is being read or added
+        std::future<ChunkData> loading;
+        /// The content of the chunk file once it was read
+        ChunkData data;
+        /// The number of entities of the chunk that were added to the scene
+        size_t added = 0;
+        /// The entities of the chunk added to the scene, used to find the parents of the entities added after them
+        std::vector<Entity2D *> entities;
+        /// The entities of the chunk without a parent
+        std::vector<Engine::Handle<Entity2D>> roots;
+      };
+
+      /// The scene this streamer is a part of
+      Scene *scene;
+      /// The directory the chunk files are read from, empty while streaming is disabled
+      std::string directory;
+      /// The size of the side of a chunk in world units
+      float chunkSize;
+      /// The distance in chunks around the camera within which chunks are loaded
+      int loadRadius;
+      /// The distance in chunks around the camera past which chunks are unloaded
+      int unloadRadius;
+      /// What happens to the chunks that leave the unload radius
+      UnloadMode unloadMode;
+      /// The maximum number of chunks kept in memory, 0 for no limit
+      size_t maxLoadedChunks;
+      /// The maximum number of chunks read at the same time
+      size_t maxConcurrentLoads;
+      /// The maximum time spent adding loaded entities to the scene each frame
+      std::chrono::steady_clock::duration commitBudget;
+      /// The chunks in memory, by packed chunk coordinates
+      std::unordered_map<uint64_t, Chunk> chunks;
+      /// The chunks that were unloaded while their file was being read, dropped once the read is done
+      std::vector<std::future<ChunkData>> abandoned;
+      /// The static group given to the next chunk that is loaded, 0 is the group of the sprites that are not streamed
+      uint32_t nextGroup;
+
+      WorldStreamer();
+
+      /// Loads, adds and unloads the chunks around the main camera, called before the pending entities are added to
+      /// the scene
+      void update();
+      /// Forgets all the chunks, waiting for the ones being read, their entities that were added are left to the scene
+      void clear();
+
+      /// Starts reading the chunks within the load radius of the given chunk, closest first
+      void requestChunks(glm::ivec2 center);
+      /// Adds the entities of the chunks that were read to the scene until the commit budget is spent
+      void commitChunks();
+      /// Unloads the chunks past the unload radius of the given chunk and the farthest ones when there are too many
+      void unloadChunks(glm::ivec2 center);
+      /// Removes the given chunk from the scene, or only deactivates it if it is not being evicted
+      void unload(Chunk &chunk, bool evict);
+      /// Adds the given entity of the chunk to the scene
+      void addEntity(Chunk &chunk, size_t index);
+
+      /// @returns The path of the file of the given chunk in the given directory
+      static std::string chunkPath(const std::string &directory, glm::ivec2 chunk);
+      /// Reads and creates the entities of the chunk file at the given path, loading the resources it uses, the sprites
+      /// of its entities are batched in the given static group
+      static ChunkData readChunk(const std::string &path, uint32_t group);
+      /// Frees the entities that were read but not added to any scene
+      static void discard(ChunkData &data, size_t from);
+      /// @returns The given chunk coordinates packed in a single key
+      static uint64_t key(glm::ivec2 chunk);
+      /// @returns The chunk coordinates packed in the given key
+      static glm::ivec2 coordinates(uint64_t key);
+      /// @returns The number of chunks between the two given chunks, diagonals included
+      static int distance(glm::ivec2 a, glm::ivec2 b);
+  };
+}
+
+#endif //WORLD_STREAMER_HPP
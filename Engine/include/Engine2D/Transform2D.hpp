@@ -7,11 +7,13 @@
 #ifndef TRANSFORM2D_H
 #define TRANSFORM2D_H
 
+#include <atomic>
 #include <vector>
 #include <glm/glm.hpp>
 
 #include "Engine/Types/Ptr.hpp"
 #include "Engine2D/Component2D.hpp"
+#include "Engine2D/Types/Affine2D.hpp"
 #include "Transform2D.gen.hpp"
 
 namespace Editor {
@@ -25,6 +27,12 @@ namespace Editor {
 namespace Engine2D {
   namespace Rendering {
     class Camera2D;
+    class Renderer2D;
+  }
+
+  namespace Physics {
+    class Physics2D;
+    class Collider2D;
   }
 
   /**
@@ -36,10 +44,17 @@ namespace Engine2D {
     SERIALIZE_TRANSFORM2D
       friend class Scene;
       friend class Entity2D;
+      friend class Physics::Physics2D;
+      friend class Physics::Collider2D;
       friend class Rendering::Camera2D;
+      friend class Rendering::Renderer2D;
       friend class Editor::EntityInspector;
       friend class Editor::History::CreateEntityCommand;
     public:
+      /// Transforms are allocated from a pool along with their entity
+      static void *operator new(size_t size);
+      static void operator delete(void *ptr);
+
       /// Equality operator to compare two Transform2D objects.
       bool operator==(const Transform2D &other) const;
       /// Inequality operator to compare two Transform2D objects.
@@ -137,6 +152,7 @@ namespace Engine2D {
       /// @returns The parent of the Entity2D this transform is attached to
       [[nodiscard]] Engine::Ptr<Entity2D> Parent() const;
       /// @returns True if the given entity is a parent of the Entity2D this transform is attached to
+      /// @note Runs in constant time for entities of the same scene once its hierarchies were flattened
       [[nodiscard]] bool IsChildOf(const Engine::Ptr<Entity2D> &entity) const;
       /// @returns True if the given entity is a child of the Entity2D this transform is attached to
       [[nodiscard]] bool IsParentOf(const Engine::Ptr<Entity2D> &entity) const;
@@ -152,11 +168,14 @@ namespace Engine2D {
       [[nodiscard]] glm::vec2 WorldScale() const;
       /// @returns The scale of the Entity2D this transform is attached to in world coordinates divided by 2
       [[nodiscard]] glm::vec2 WorldHalfScale() const;
-      /// @returns The transform matrix of this entity
-      [[nodiscard]] const glm::mat4 &WorldMatrix();
+      /// @returns The transformation from the local space of this entity to world space
+      [[nodiscard]] Affine2D WorldMatrix() const;
+      /// @returns A number that increases every time the world position, rotation or scale of this transform change,
+      /// compare it with the one recorded when they were last read to know if they need to be read again
+      [[nodiscard]] uint32_t Version() const;
 
       /// @returns The given point for world to local coordinates
-      [[nodiscard]] glm::vec2 WorldToLocal(const glm::vec2 &point);
+      [[nodiscard]] glm::vec2 WorldToLocal(const glm::vec2 &point) const;
 
       [[nodiscard]] const std::vector<Engine::Ptr<Entity2D>> &Children() const;
       /// Sets the parent of all the children of the Entity2D this transform is attached to the current scene's root
@@ -194,18 +213,43 @@ namespace Engine2D {
       ENGINE_SERIALIZE glm::vec2 scale;
       /// Scale of the transform in world space.
       ENGINE_SERIALIZE_HIDDEN glm::vec2 worldScale;
+      /// Rotation and scale of the transform in world space combined with those of its parents, used to place the
+      /// children of this transform
+      glm::mat2 worldLinear;
 
       /// The parent Entity2D of the entity that this transform is attached to
       Engine::Ptr<Entity2D> parent;
       /// The list of all the children of this entity
       std::vector<Engine::Ptr<Entity2D>> children;
 
-      /// If the transform matrix needs to be recomputed
-      bool dirty;
-      /// If this entity is on screen
-      bool visible;
-      /// Transform matrix
-      glm::mat4 projectionMatrix;
+      /// If the local position, rotation or scale changed since the world ones were computed
+      bool worldDirty;
+      /// Incremented every time the world values of this transform change, starts at 1
+      uint32_t version;
+      /// The version of this transform the visibility was computed for shifted by one bit, with whether this entity is
+      /// on screen in the lowest bit, 0 if it needs to be recomputed. Kept in a single word accessed atomically since
+      /// the renderers of an entity are culled from different workers
+      alignas(std::atomic_ref<uint64_t>::required_alignment) uint64_t visibility;
+      /// Position of the transform in world space before the last physics step that moved it
+      glm::vec2 previousWorldPosition;
+      /// Rotation of the transform in radians in world space before the last physics step that moved it
+      float previousWorldRotation;
+      /// The physics step during which the previous world position and rotation were recorded
+      uint64_t previousPhysicsStep;
+      /// The index of this transform in the flattened hierarchies of its scene, its descendants are the transforms
+      /// between this index and hierarchyEnd
+      uint32_t hierarchyIndex;
+      /// The index past the last descendant of this transform in the flattened hierarchies of its scene, 0 if this
+      /// transform was never flattened
+      uint32_t hierarchyEnd;
+
+      /// The position, rotation, scale and linear transformation of a transform in world space
+      struct World final {
+        glm::vec2 position = glm::vec2(0.0f);
+        float rotation = 0.0f;
+        glm::vec2 scale = glm::vec2(1.0f);
+        glm::mat2 linear = glm::mat2(1.0f);
+      };
 
       Transform2D();
 
@@ -222,8 +266,24 @@ namespace Engine2D {
         const Engine::Ptr<Entity2D> &parent = {}
       );
 
-      /// Callback function that updates fields of this transform only if any of its public properties are modified
+      /// @returns The world position to render this transform at, interpolated if it was moved by the given physics step
+      [[nodiscard]] glm::vec2 interpolatedWorldPosition(float interpolation, uint64_t physicsStep) const;
+      /// @returns The world rotation to render this transform at, interpolated if it was moved by the given physics step
+      [[nodiscard]] float interpolatedWorldRotation(float interpolation, uint64_t physicsStep) const;
+      /// Recomputes the world values of this transform and of its children right away
       void onTransformChange();
+      /// Marks the world values of this transform as outdated, they are recomputed along with those of its children by
+      /// the next propagation pass of the scene, or right away if the entity is not part of a scene yet
+      void markDirty();
+      /// @returns True if the world values of this transform or of one of its parents wait for a propagation pass
+      [[nodiscard]] bool worldOutdated() const;
+      /// @returns The world values of this transform, computed from those of its parents if they are outdated
+      [[nodiscard]] World world() const;
+      /// @returns The world values of this transform placed in the given world values of its parent
+      [[nodiscard]] World composeWorld(const World &parentWorld) const;
+      /// Sets the world values of this transform and flags it to be redrawn if they changed
+      /// @returns True if the world values changed, false if not
+      bool applyWorld(const World &values);
       /// Callback function that updates the active state of the entity when it's parent list changes
       void onParentHierarchyChange() const;
 
@@ -0,0 +1,100 @@
+//
+// Affine2D.hpp
+// Author: Antoine Bastide
+// Date: 16.10.2026
+//
+
+#ifndef AFFINE2D_HPP
+#define AFFINE2D_HPP
+
+#include <cmath>
+#include <glm/glm.hpp>
+
+namespace Engine2D {
+  /**
+   * 2D affine transformation stored as a 2x3 matrix: a linear part for the rotation, scale and shear followed by a
+   * translation.
+   * Takes 24 bytes instead of the 64 of a glm::mat4 and is composed, applied and inverted without going through 4x4
+   * matrix products.
+   */
+  struct Affine2D final {
+    /// The rotation, scale and shear of the transformation
+    glm::mat2 linear = glm::mat2(1.0f);
+    /// The translation applied after the linear part
+    glm::vec2 translation = glm::vec2(0.0f);
+
+    Affine2D() = default;
+
+    Affine2D(const glm::mat2 &linear, const glm::vec2 translation)
+      : linear(linear), translation(translation) {}
+
+    /// @returns The transformation that scales, then rotates by the given counterclockwise angle in radians, then
+    /// translates
+    [[nodiscard]] static Affine2D TRS(const glm::vec2 translation, const float rotation, const glm::vec2 scale) {
+      const float cos = std::cos(rotation);
+      const float sin = std::sin(rotation);
+      return {glm::mat2(glm::vec2(cos, sin) * scale.x, glm::vec2(-sin, cos) * scale.y), translation};
+    }
+
+    /// @returns The transformation that scales by the given factors
+    [[nodiscard]] static Affine2D Scale(const glm::vec2 scale) {
+      return {glm::mat2(scale.x, 0.0f, 0.0f, scale.y), glm::vec2(0.0f)};
+    }
+
+    /// @returns The transformation that translates by the given offset
+    [[nodiscard]] static Affine2D Translation(const glm::vec2 translation) {
+      return {glm::mat2(1.0f), translation};
+    }
+
+    /// @returns The given point transformed by this transformation
+    [[nodiscard]] glm::vec2 TransformPoint(const glm::vec2 point) const {
+      return linear * point + translation;
+    }
+
+    /// @returns The given direction transformed by this transformation, the translation is ignored
+    [[nodiscard]] glm::vec2 TransformVector(const glm::vec2 vector) const {
+      return linear * vector;
+    }
+
+    /// @returns The inverse of this transformation, the identity if it can not be inverted
+    [[nodiscard]] Affine2D Inverse() const {
+      const float determinant = linear[0][0] * linear[1][1] - linear[1][0] * linear[0][1];
+      if (determinant == 0.0f)
+        return {};
+
+      const float inverseDeterminant = 1.0f / determinant;
+      const glm::mat2 inverse(
+        linear[1][1] * inverseDeterminant, -linear[0][1] * inverseDeterminant,
+        -linear[1][0] * inverseDeterminant, linear[0][0] * inverseDeterminant
+      );
+      return {inverse, -(inverse * translation)};
+    }
+
+    /// @returns This transformation as a 4x4 matrix that leaves the z axis untouched, used to upload it to shaders
+    [[nodiscard]] glm::mat4 ToMat4() const {
+      glm::mat4 matrix(1.0f);
+      matrix[0][0] = linear[0][0];
+      matrix[0][1] = linear[0][1];
+      matrix[1][0] = linear[1][0];
+      matrix[1][1] = linear[1][1];
+      matrix[3][0] = translation.x;
+      matrix[3][1] = translation.y;
+      return matrix;
+    }
+
+    /// @returns The transformation that applies the given one first, then this one
+    Affine2D operator*(const Affine2D &other) const {
+      return {linear * other.linear, linear * other.translation + translation};
+    }
+
+    bool operator==(const Affine2D &other) const {
+      return linear == other.linear && translation == other.translation;
+    }
+
+    bool operator!=(const Affine2D &other) const {
+      return !(*this == other);
+    }
+  };
+}
+
+#endif //AFFINE2D_HPP
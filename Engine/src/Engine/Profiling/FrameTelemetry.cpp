@@ -0,0 +1,168 @@
+//
+// FrameTelemetry.cpp
+// Author: Antoine Bastide
+// Date: 16.10.2026
+//
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+#include "Engine/Profiling/FrameTelemetry.hpp"
+#include "Engine/Threading/JobSystem.hpp"
+
+namespace Engine::Profiling {
+  FrameTelemetry::ScopedStage::ScopedStage(const Stage stage)
+    : ScopedStage(stage, frameIndex.load(std::memory_order_relaxed)) {}
+
+  FrameTelemetry::ScopedStage::ScopedStage(const Stage stage, const uint64_t frame)
+    : stage(stage), frame(frame), recorded(!Engine::Threading::JobSystem::Context()),
+      start(std::chrono::steady_clock::now()) {}
+
+  FrameTelemetry::ScopedStage::~ScopedStage() {
+    // Scenes stepped side by side have no frame of their own, adding them to the frame of the game would sum them
+    if (recorded)
+      record(stage, std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count(), frame);
+  }
+
+  void FrameTelemetry::SetCapacity(const size_t capacity) {
+    std::lock_guard lock(mutex);
+    FrameTelemetry::capacity = std::max<size_t>(capacity, 1);
+    frames.clear();
+    frames.shrink_to_fit();
+    head = 0;
+    count = 0;
+  }
+
+  size_t FrameTelemetry::Capacity() {
+    std::lock_guard lock(mutex);
+    return capacity;
+  }
+
+  size_t FrameTelemetry::FrameCount() {
+    std::lock_guard lock(mutex);
+    return count;
+  }
+
+  FrameTelemetry::Statistics FrameTelemetry::Query(const Stage stage) {
+    if (stage >= Count)
+      return {};
+
+    std::vector<float> times;
+    {
+      std::lock_guard lock(mutex);
+      times.reserve(count);
+      for (size_t i = 0; i < count; ++i)
+        times.emplace_back(frames[i][stage]);
+    }
+    if (times.empty())
+      return {};
+
+    Statistics statistics;
+    const auto [min, max] = std::ranges::minmax_element(times);
+    statistics.min = *min;
+    statistics.max = *max;
+    double sum = 0.0;
+    for (const float time: times)
+      sum += time;
+    statistics.average = static_cast<float>(sum / static_cast<double>(times.size()));
+
+    // Nearest rank percentiles, the 99th is searched in the part left after the 95th
+    const auto rank = [&times](const float percentile) {
+      const auto index = static_cast<size_t>(std::ceil(percentile * static_cast<float>(times.size())));
+      return std::clamp<size_t>(index, 1, times.size()) - 1;
+    };
+    const size_t p95 = rank(0.95f);
+    std::ranges::nth_element(times, times.begin() + p95);
+    statistics.p95 = times[p95];
+    const size_t p99 = rank(0.99f);
+    std::nth_element(times.begin() + p95, times.begin() + p99, times.end());
+    statistics.p99 = times[p99];
+
+    return statistics;
+  }
+
+  float FrameTelemetry::Last(const Stage stage) {
+    std::lock_guard lock(mutex);
+    if (stage >= Count || count == 0)
+      return 0.0f;
+    return frames[(head + capacity - 1) % capacity][stage];
+  }
+
+  float FrameTelemetry::FramesPerSecond() {
+    const float average = Query(Frame).average;
+    return average > 0.0f ? 1000.0f / average : 0.0f;
+  }
+
+  const char *FrameTelemetry::StageName(const Stage stage) {
+    switch (stage) {
+      case Input: return "Input";
+      case Sync: return "Sync";
+      case Update: return "Update";
+      case FixedUpdate: return "FixedUpdate";
+      case Physics: return "Physics";
+      case Animate: return "Animate";
+      case Extract: return "Extract";
+      case Submit: return "Submit";
+      case Frame: return "Frame";
+      default: return "Unknown";
+    }
+  }
+
+  bool FrameTelemetry::Export(const std::string &path) {
+    std::ofstream file(path);
+    if (!file.is_open())
+      return false;
+
+    file << "frame";
+    for (uint8_t stage = 0; stage < Count; ++stage)
+      file << ',' << StageName(static_cast<Stage>(stage));
+    file << '\n';
+
+    std::lock_guard lock(mutex);
+    // Once the buffer is full, the oldest frame is the one that will be overwritten next
+    const size_t first = count == capacity ? head : 0;
+    for (size_t i = 0; i < count; ++i) {
+      file << i;
+      for (const float time: frames[(first + i) % capacity])
+        file << ',' << time;
+      file << '\n';
+    }
+
+    return file.good();
+  }
+
+  void FrameTelemetry::Clear() {
+    std::lock_guard lock(mutex);
+    head = 0;
+    count = 0;
+    current.fill(0.0f);
+  }
+
+  void FrameTelemetry::record(const Stage stage, const float milliseconds, const uint64_t frame) {
+    std::lock_guard lock(mutex);
+    const uint64_t inProgress = frameIndex.load(std::memory_order_relaxed);
+    if (frame == inProgress) {
+      current[stage] += milliseconds;
+      return;
+    }
+
+    // The render thread draws a frame after the update thread has ended it, the time is added to the recorded frame if
+    // it is still in the buffer
+    if (const uint64_t age = inProgress - 1 - frame; frame < inProgress && age < count)
+      frames[(head + capacity - 1 - age) % capacity][stage] += milliseconds;
+  }
+
+  void FrameTelemetry::endFrame(const float milliseconds) {
+    std::lock_guard lock(mutex);
+    current[Frame] = milliseconds;
+
+    if (frames.size() < capacity)
+      frames.resize(capacity);
+    frames[head] = current;
+    head = (head + 1) % capacity;
+    count = std::min(count + 1, capacity);
+    current.fill(0.0f);
+    frameIndex.fetch_add(1, std::memory_order_relaxed);
+  }
+}
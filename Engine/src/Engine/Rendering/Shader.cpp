@@ -45,13 +45,14 @@ namespace Engine::Rendering {
     }
 
     // Build the shader and link it
-    id = glCreateProgram();
-    glAttachShader(id, sVertex);
-    glAttachShader(id, sFragment);
+    const uint program = glCreateProgram();
+    glAttachShader(program, sVertex);
+    glAttachShader(program, sFragment);
     if (geometrySource)
-      glAttachShader(id, gShader);
-    glLinkProgram(id);
-    checkCompileErrors(id, "PROGRAM");
+      glAttachShader(program, gShader);
+    glLinkProgram(program);
+    checkCompileErrors(program, "PROGRAM");
+    id = program;
 
     // Delete the pieces of the shader that won't be used anymore
     glDeleteShader(sVertex);
@@ -129,10 +130,8 @@ namespace Engine::Rendering {
   }
 
   void Shader::clear() {
-    if (this->id > 0) {
-      glDeleteProgram(this->id);
-      id = 0;
-    }
+    if (const uint program = id.exchange(0); program > 0)
+      glDeleteProgram(program);
   }
 
   void Shader::checkCompileErrors(const uint object, const std::string &type) {
@@ -36,19 +36,13 @@ namespace Engine::Rendering {
     return transparent;
   }
 
-  void Texture::generate(
-    const int width, const int height, const unsigned char *data, const int internalFormat, const int dataFormat,
-    const bool transparent, const bool blended
-  ) {
+  void Texture::generate(const unsigned char *data, const int internalFormat, const int dataFormat, const bool blended) {
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSystem);
 
-    this->width = width;
-    this->height = height;
-    this->transparent = transparent;
-
     // create Texture
-    glGenTextures(1, &this->id);
-    glBindTexture(GL_TEXTURE_2D, this->id);
+    uint textureId = 0;
+    glGenTextures(1, &textureId);
+    glBindTexture(GL_TEXTURE_2D, textureId);
     glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, dataFormat, GL_UNSIGNED_BYTE, data);
 
     // set Texture wrap and filter modes
@@ -59,13 +53,14 @@ namespace Engine::Rendering {
 
     // unbind texture
     glBindTexture(GL_TEXTURE_2D, 0);
+
+    // Only publish the id once the texture is complete, other threads use it to know if it can be drawn
+    id = textureId;
   }
 
   void Texture::clear() {
-    if (this->id > 0) {
-      glDeleteTextures(1, &this->id);
-      id = 0;
-    }
+    if (const uint textureId = id.exchange(0); textureId > 0)
+      glDeleteTextures(1, &textureId);
   }
 
   void Texture::bind(const int offset) const {
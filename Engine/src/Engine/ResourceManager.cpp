@@ -33,8 +33,11 @@ namespace Engine {
       return Log::Error("Shader file path is required to load a shader");
     if (name.empty())
       return Log::Error("Shader name is required to load a shader");
-    if (shaders.contains(name))
-      return shaders.at(name).get();
+    {
+      std::lock_guard lock(mutex);
+      if (shaders.contains(name))
+        return shaders.at(name).get();
+    }
 
     // Load the whole shader file
     const cmrc::file shaderFile = Game2D::instance->loadResource(filePath);
@@ -51,35 +54,46 @@ namespace Engine {
     if (fragmentCode.empty())
       return Log::Error("Fragment shader stage missing");
 
-    // Compile shader
-    auto shader = std::make_unique<Shader>();
-    shader->compile(
-      vertexCode.c_str(), fragmentCode.c_str(),
-      geometryCode.empty() ? nullptr : geometryCode.c_str()
-    );
-    shader->use();
-
-    // Bind the engine data to the shader
-    if (const GLuint blockIndex = glGetUniformBlockIndex(shader->Id(), "Matrices"); blockIndex != GL_INVALID_INDEX)
-      glUniformBlockBinding(shader->Id(), blockIndex, Engine2D::Rendering::Camera2D::ENGINE_DATA_BINDING_PORT);
-
-    // Tell the shader how many textures it can hold
-    if (const GLint texturesLoc = glGetUniformLocation(shader->Id(), "textures"); texturesLoc != -1) {
-      std::vector<int> locations;
-      locations.reserve(Engine2D::Rendering::Renderer2D::MAX_TEXTURES);
-      locations.resize(Engine2D::Rendering::Renderer2D::MAX_TEXTURES);
-      for (size_t i = 0; i < Engine2D::Rendering::Renderer2D::MAX_TEXTURES; ++i)
-        locations.at(i) = static_cast<int>(i);
-      glUniform1iv(texturesLoc, Engine2D::Rendering::Renderer2D::MAX_TEXTURES, locations.data());
-    }
+    // The file is read without holding the lock, so the shader might have been loaded by another thread in the meantime
+    std::lock_guard lock(mutex);
+    if (shaders.contains(name))
+      return shaders.at(name).get();
 
+    auto shader = std::make_unique<Shader>();
     shader->name = name;
     shader->path = filePath;
+
+    // Compile the shader on the render thread, it is not drawn until it has been linked
+    Game2D::RunOnRenderThread(
+      [shader = shader.get(), vertexCode, fragmentCode, geometryCode] {
+        shader->compile(
+          vertexCode.c_str(), fragmentCode.c_str(),
+          geometryCode.empty() ? nullptr : geometryCode.c_str()
+        );
+        shader->use();
+
+        // Bind the engine data to the shader
+        if (const GLuint blockIndex = glGetUniformBlockIndex(shader->Id(), "Matrices"); blockIndex != GL_INVALID_INDEX)
+          glUniformBlockBinding(shader->Id(), blockIndex, Engine2D::Rendering::Camera2D::ENGINE_DATA_BINDING_PORT);
+
+        // Tell the shader how many textures it can hold
+        if (const GLint texturesLoc = glGetUniformLocation(shader->Id(), "textures"); texturesLoc != -1) {
+          std::vector<int> locations;
+          locations.reserve(Engine2D::Rendering::Renderer2D::MAX_TEXTURES);
+          locations.resize(Engine2D::Rendering::Renderer2D::MAX_TEXTURES);
+          for (size_t i = 0; i < Engine2D::Rendering::Renderer2D::MAX_TEXTURES; ++i)
+            locations.at(i) = static_cast<int>(i);
+          glUniform1iv(texturesLoc, Engine2D::Rendering::Renderer2D::MAX_TEXTURES, locations.data());
+        }
+      }
+    );
+
     shaders.emplace(name, std::move(shader));
     return shaders.at(name).get();
   }
 
   Shader *ResourceManager::GetShader(const std::string &name) {
+    std::lock_guard lock(mutex);
     if (shaders.contains(name))
       return shaders.at(name).get();
     return Log::Error("Unknown shader: " + name);
@@ -88,6 +102,7 @@ namespace Engine {
   Shader *ResourceManager::GetShaderById(const uint id) {
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSubSystem);
 
+    std::lock_guard lock(mutex);
     for (const auto &val: shaders | std::views::values)
       if (val->id == id)
         return val.get();
@@ -101,8 +116,11 @@ namespace Engine {
       return Log::Error("File path is required to load a texture");
     if (name.empty())
       return Log::Error("Name is required to load a texture");
-    if (textures.contains(name))
-      return textures.at(name).get();
+    {
+      std::lock_guard lock(mutex);
+      if (textures.contains(name))
+        return textures.at(name).get();
+    }
 
     // Load the image from cmrc
     const auto file = Game2D::instance->loadResource(filePath);
@@ -147,10 +165,25 @@ namespace Engine {
 
     ENGINE_ASSERT(internalFormat & dataFormat, "Image format is not supported");
 
-    // Generate the texture and free the image data
+    // The image is decoded without holding the lock, so the texture might have been loaded by another thread meanwhile
+    std::lock_guard lock(mutex);
+    if (textures.contains(name)) {
+      stbi_image_free(data);
+      return textures.at(name).get();
+    }
+
     auto texture = std::make_unique<Texture>();
-    texture->generate(width, height, data, internalFormat, dataFormat, transparent, blend);
-    stbi_image_free(data);
+    texture->width = width;
+    texture->height = height;
+    texture->transparent = transparent;
+
+    // Upload the texture on the render thread and free the image data once it is done, it is not drawn until then
+    const std::shared_ptr<unsigned char> pixels(data, stbi_image_free);
+    Game2D::RunOnRenderThread(
+      [texture = texture.get(), pixels, internalFormat, dataFormat, blend] {
+        texture->generate(pixels.get(), internalFormat, dataFormat, blend);
+      }
+    );
 
     texture->name = name;
     texture->path = filePath;
@@ -159,6 +192,7 @@ namespace Engine {
   }
 
   Texture *ResourceManager::GetTexture2D(const std::string &name) {
+    std::lock_guard lock(mutex);
     if (textures.contains(name))
       return textures.at(name).get();
     return Log::Error("Unknown texture: " + name);
@@ -167,6 +201,7 @@ namespace Engine {
   Texture *ResourceManager::GetTexture2DById(const uint id) {
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSystem);
 
+    std::lock_guard lock(mutex);
     for (const auto &val: textures | std::views::values)
       if (val->id == id)
         return val.get();
@@ -174,6 +209,7 @@ namespace Engine {
   }
 
   Sprite *ResourceManager::GetSprite(const std::string &name) {
+    std::lock_guard lock(mutex);
     if (sprites.contains(name))
       return sprites.at(name).get();
     return nullptr;
@@ -190,6 +226,7 @@ namespace Engine {
   }
 
   Sprite *ResourceManager::CreateSpriteFromTexture(const std::string &textureName, const glm::vec4 &rect) {
+    std::lock_guard lock(mutex);
     if (!textures.contains(textureName))
       return Log::Error("Texture not found: " + textureName);
 
@@ -207,6 +244,7 @@ namespace Engine {
   Sprite *ResourceManager::CreateSprite(
     const std::string &spriteName, const std::string &textureName, const glm::vec4 &rect
   ) {
+    std::lock_guard lock(mutex);
     if (!textures.contains(textureName))
       return Log::Error("Texture not found: " + textureName);
     if (sprites.contains(spriteName))
@@ -224,6 +262,7 @@ namespace Engine {
   }
 
   const std::string &ResourceManager::GetShaderName(const Shader *shader) {
+    std::lock_guard lock(mutex);
     for (const auto &[k, v]: shaders)
       if (v.get() == shader)
         return k;
@@ -231,6 +270,7 @@ namespace Engine {
   }
 
   const std::string &ResourceManager::GetTexture2DName(const Texture *texture) {
+    std::lock_guard lock(mutex);
     for (const auto &[k, v]: textures)
       if (v.get() == texture)
         return k;
@@ -238,6 +278,7 @@ namespace Engine {
   }
 
   const std::string &ResourceManager::GetSpriteName(const Sprite *sprite) {
+    std::lock_guard lock(mutex);
     for (const auto &[k, v]: sprites)
       if (v.get() == sprite)
         return k;
@@ -245,6 +286,7 @@ namespace Engine {
   }
 
   void ResourceManager::Clear() {
+    std::lock_guard lock(mutex);
     for (const auto &shader: shaders | std::views::values)
       shader->clear();
     shaders.clear();
@@ -73,6 +73,22 @@ namespace Engine {
     }
   }
 
+  void Settings::Graphics::SetIdleWhenUnfocused(const bool newState) {
+    idleWhenUnfocused = newState;
+  }
+
+  void Settings::Graphics::SetIdleTimeout(const float newValue) {
+    idleTimeout = std::max(newValue, 0.0f);
+  }
+
+  void Settings::Graphics::SetIdleFrameRate(const unsigned int newValue) {
+    idleFrameRate = std::max(newValue, 1u);
+  }
+
+  void Settings::Graphics::SetRenderCommandBudget(const float newValue) {
+    renderCommandBudget = std::max(newValue, 0.0f);
+  }
+
   bool Settings::Graphics::VsyncEnabled() {
     return vsyncEnabled;
   }
@@ -85,39 +101,94 @@ namespace Engine {
     return targetFrameRate;
   }
 
+  bool Settings::Graphics::IdleWhenUnfocused() {
+    return idleWhenUnfocused;
+  }
+
+  float Settings::Graphics::IdleTimeout() {
+    return idleTimeout;
+  }
+
+  unsigned int Settings::Graphics::IdleFrameRate() {
+    return idleFrameRate;
+  }
+
+  float Settings::Graphics::RenderCommandBudget() {
+    return renderCommandBudget;
+  }
+
+  Settings::Physics::Values &Settings::Physics::current() {
+    if (const auto scene = Engine2D::SceneManager::ActiveScene())
+      return scene->physicsSettings;
+    return defaults;
+  }
+
+  template<typename T> void Settings::Physics::set(T Values::*setting, T value) {
+    if (const auto scene = Engine2D::SceneManager::ActiveScene())
+      scene->physicsSettings.*setting = value;
+    // A scene stepped on its own thread only changes its own settings
+    if (!Engine2D::SceneManager::steppedScene())
+      defaults.*setting = value;
+  }
+
   void Settings::Physics::SetFixedDeltaTime(const float newValue) {
-    static constexpr float min = 0.02f;
-    static constexpr float max = 1.0f / 60.0f;
-    fixedDeltaTime = std::clamp(newValue, min, max);
+    static constexpr float min = 1.0f / 120.0f;
+    static constexpr float max = 1.0f / 20.0f;
+    set(&Values::fixedDeltaTime, std::clamp(newValue, min, max));
+  }
+
+  void Settings::Physics::SetMaxSubsteps(const uint newValue) {
+    set(&Values::maxSubsteps, std::max(newValue, 1u));
+  }
+
+  void Settings::Physics::SetInterpolation(const bool newState) {
+    set(&Values::interpolation, newState);
   }
 
   void Settings::Physics::SetUseScreenPartitioning(const bool newState) {
-    useScreenPartitioning = newState;
+    set(&Values::broadPhase, newState ? BroadPhase::Grid : BroadPhase::SortAndSweep);
+  }
+
+  void Settings::Physics::SetBroadPhaseMethod(const BroadPhase newValue) {
+    set(&Values::broadPhase, newValue);
   }
 
   void Settings::Physics::SetPartitionSize(const glm::vec<2, size_t> newValue) {
-    partitionSize = newValue;
-    Engine2D::SceneManager::ActiveScene()->physicsSystem.collisionGridNeedsResizing = true;
+    set(&Values::partitionSize, newValue);
+    if (const auto scene = Engine2D::SceneManager::ActiveScene())
+      scene->physicsSystem.collisionGridNeedsResizing = true;
   }
 
   void Settings::Physics::SetGravity(const glm::vec2 newValue) {
-    gravity = newValue;
+    set(&Values::gravity, newValue);
   }
 
   float Settings::Physics::FixedDeltaTime() {
-    return fixedDeltaTime;
+    return current().fixedDeltaTime;
+  }
+
+  uint Settings::Physics::MaxSubsteps() {
+    return current().maxSubsteps;
+  }
+
+  bool Settings::Physics::Interpolation() {
+    return current().interpolation;
   }
 
   bool Settings::Physics::UseScreenPartitioning() {
-    return useScreenPartitioning;
+    return current().broadPhase == BroadPhase::Grid;
+  }
+
+  Settings::Physics::BroadPhase Settings::Physics::BroadPhaseMethod() {
+    return current().broadPhase;
   }
 
   glm::vec<2, size_t> Settings::Physics::PartitionSize() {
-    return partitionSize;
+    return current().partitionSize;
   }
 
   glm::vec2 Settings::Physics::Gravity() {
-    return gravity;
+    return current().gravity;
   }
 
   void Settings::Input::SetAllowMouseInput(const bool newState) {
@@ -160,6 +231,30 @@ namespace Engine {
     return gamepadTriggerThreshold;
   }
 
+  void Settings::Threading::SetThreadingModel(const Model newValue) {
+    threadingModel = newValue;
+  }
+
+  void Settings::Threading::SetWorkerCount(const uint newValue) {
+    workerCount = newValue;
+  }
+
+  void Settings::Threading::SetAffinity(const std::vector<uint> &newValue) {
+    affinity = newValue;
+  }
+
+  Settings::Threading::Model Settings::Threading::ThreadingModel() {
+    return threadingModel;
+  }
+
+  uint Settings::Threading::WorkerCount() {
+    return workerCount;
+  }
+
+  const std::vector<uint> &Settings::Threading::Affinity() {
+    return affinity;
+  }
+
   void Settings::Profiling::SetProfilingLevel(const Level newValue) {
     profilingLevel = newValue;
   }
@@ -0,0 +1,325 @@
+//
+// JobSystem.cpp
+// Author: Antoine Bastide
+// Date: 16.10.2026
+//
+
+#include <algorithm>
+#if defined(ENGINE_LINUX)
+#include <pthread.h>
+#elif defined(ENGINE_WINDOWS_X64)
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+#include "Engine/Threading/JobSystem.hpp"
+#include "Engine/Log.hpp"
+#include "Engine/Macros/Profiling.hpp"
+
+namespace Engine::Threading {
+  /// Pins the given thread to the given core
+  /// @returns True if the thread was pinned, false if not
+  static bool pinThread(const std::thread::native_handle_type handle, const uint core) {
+    if (core >= std::thread::hardware_concurrency())
+      return false;
+
+    #if defined(ENGINE_LINUX)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    return pthread_setaffinity_np(handle, sizeof(cpu_set_t), &set) == 0;
+    #elif defined(ENGINE_WINDOWS_X64)
+    return SetThreadAffinityMask(static_cast<HANDLE>(handle), 1ull << core) != 0;
+    #else
+    // macOS only supports affinity hints, threads can not be pinned to a core
+    (void)handle;
+    return false;
+    #endif
+  }
+
+  bool JobCounter::IsDone() const {
+    return pending.load(std::memory_order_acquire) == 0;
+  }
+
+  void JobSystem::Initialize(const size_t workerCount, const std::vector<uint> &cores) {
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerFunction);
+
+    if (running)
+      Shutdown();
+
+    // Without workers, all the jobs are executed inline
+    if (workerCount == 0)
+      return;
+
+    queues.reserve(workerCount + 1);
+    for (size_t i = 0; i <= workerCount; ++i)
+      queues.emplace_back(std::make_unique<WorkQueue>());
+
+    running = true;
+    workers.reserve(workerCount);
+    for (size_t i = 1; i <= workerCount; ++i) {
+      auto &worker = workers.emplace_back(workerLoop, i);
+      if (cores.empty())
+        continue;
+      if (const uint core = cores[(i - 1) % cores.size()]; !pinThread(worker.native_handle(), core))
+        Log::Warning("Could not pin worker " + std::to_string(i) + " to core " + std::to_string(core));
+    }
+  }
+
+  void JobSystem::Shutdown() {
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerFunction);
+
+    if (!running)
+      return;
+
+    // The workers drain the remaining jobs before exiting
+    {
+      std::lock_guard lock(sleepMutex);
+      running = false;
+    }
+    sleepCV.notify_all();
+
+    for (auto &worker: workers)
+      if (worker.joinable())
+        worker.join();
+    workers.clear();
+    queues.clear();
+  }
+
+  size_t JobSystem::WorkerCount() {
+    return workers.size();
+  }
+
+  bool JobSystem::IsRunning() {
+    return running;
+  }
+
+  size_t JobSystem::DefaultWorkerCount(const size_t reservedThreads) {
+    const size_t cores = std::max(std::thread::hardware_concurrency(), 1u);
+    return cores > reservedThreads ? cores - reservedThreads : 0;
+  }
+
+  bool JobSystem::PinCurrentThread(const uint core) {
+    #if defined(ENGINE_LINUX)
+    return pinThread(pthread_self(), core);
+    #elif defined(ENGINE_WINDOWS_X64)
+    return pinThread(GetCurrentThread(), core);
+    #else
+    return pinThread({}, core);
+    #endif
+  }
+
+  void JobSystem::Schedule(Job job, JobCounter *counter) {
+    if (counter)
+      counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+    if (!running) {
+      QueuedJob queuedJob{std::move(job), counter, context};
+      execute(queuedJob);
+      return;
+    }
+
+    // Count the job before pushing it so that the workers never see more jobs than there are in the queues
+    queuedJobs.fetch_add(1, std::memory_order_release);
+    {
+      auto &queue = *queues[queueIndex];
+      std::lock_guard lock(queue.mutex);
+      queue.jobs.push_back({std::move(job), counter, context});
+    }
+
+    // Lock the sleep mutex to prevent the wake-up from being lost while a worker is about to go to sleep
+    { std::lock_guard lock(sleepMutex); }
+    sleepCV.notify_one();
+  }
+
+  void JobSystem::Wait(const JobCounter &counter) {
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerFunction);
+
+    while (!counter.IsDone())
+      if (!executeNext(queueIndex))
+        std::this_thread::yield();
+  }
+
+  void JobSystem::ParallelFor(const size_t count, size_t grainSize, const RangeJob &job) {
+    if (count == 0)
+      return;
+
+    grainSize = std::max<size_t>(grainSize, 1);
+    if (!running || count <= grainSize) {
+      job(0, count);
+      return;
+    }
+
+    // Create a few chunks per thread so that threads that finish early can steal the remaining ones
+    constexpr size_t chunksPerThread = 4;
+    const size_t maxChunkCount = (workers.size() + 1) * chunksPerThread;
+    const size_t chunkCount = std::min(maxChunkCount, (count + grainSize - 1) / grainSize);
+    const size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+    JobCounter counter;
+    for (size_t begin = chunkSize; begin < count; begin += chunkSize) {
+      const size_t end = std::min(begin + chunkSize, count);
+      Schedule(
+        [&job, begin, end] {
+          job(begin, end);
+        }, &counter
+      );
+    }
+
+    job(0, std::min(chunkSize, count));
+    Wait(counter);
+  }
+
+  void JobSystem::SetContext(void *context) {
+    JobSystem::context = context;
+  }
+
+  void *JobSystem::Context() {
+    return context;
+  }
+
+  void JobSystem::workerLoop(const size_t index) {
+    queueIndex = index;
+
+    while (true) {
+      if (executeNext(index))
+        continue;
+
+      std::unique_lock lock(sleepMutex);
+      sleepCV.wait(
+        lock, [] {
+          return queuedJobs.load(std::memory_order_acquire) > 0 || !running;
+        }
+      );
+      if (!running && queuedJobs.load(std::memory_order_acquire) == 0)
+        break;
+    }
+  }
+
+  bool JobSystem::executeNext(const size_t index) {
+    if (queuedJobs.load(std::memory_order_acquire) == 0 || queues.empty())
+      return false;
+
+    // Pop the newest job from the owned queue, steal the oldest job from the others
+    const size_t queueCount = queues.size();
+    for (size_t i = 0; i < queueCount; ++i) {
+      auto &queue = *queues[(index + i) % queueCount];
+      std::unique_lock lock(queue.mutex);
+      if (queue.jobs.empty())
+        continue;
+
+      QueuedJob queuedJob;
+      if (i == 0) {
+        queuedJob = std::move(queue.jobs.back());
+        queue.jobs.pop_back();
+      } else {
+        queuedJob = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+      }
+      lock.unlock();
+
+      queuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+      execute(queuedJob);
+      return true;
+    }
+    return false;
+  }
+
+  void JobSystem::execute(QueuedJob &queuedJob) {
+    // A thread waiting on its own jobs can pick up the job of another context, so the context is restored afterward
+    void *const previous = context;
+    context = queuedJob.context;
+    if (queuedJob.job)
+      queuedJob.job();
+    context = previous;
+    if (queuedJob.counter)
+      queuedJob.counter->pending.fetch_sub(1, std::memory_order_acq_rel);
+  }
+
+  TaskGraph::TaskId TaskGraph::Add(Job job) {
+    auto &task = tasks.emplace_back(std::make_unique<Task>());
+    task->job = std::move(job);
+    validated = false;
+    return tasks.size() - 1;
+  }
+
+  void TaskGraph::Precede(const TaskId before, const TaskId after) {
+    if (before >= tasks.size() || after >= tasks.size() || before == after) {
+      Log::Error("Invalid task dependency: " + std::to_string(before) + " -> " + std::to_string(after));
+      return;
+    }
+
+    tasks[before]->successors.emplace_back(after);
+    tasks[after]->dependencyCount++;
+    validated = false;
+  }
+
+  void TaskGraph::Run() {
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSubSystem);
+
+    if (tasks.empty())
+      return;
+
+    // A cycle would make the graph wait forever on tasks that can never start
+    if (!validated) {
+      if (!isAcyclic()) {
+        Log::Error("Task graph contains a cycle, it will not be run");
+        return;
+      }
+      validated = true;
+    }
+
+    for (const auto &task: tasks)
+      task->remainingDependencies.store(task->dependencyCount, std::memory_order_relaxed);
+    for (TaskId id = 0; id < tasks.size(); ++id)
+      if (tasks[id]->dependencyCount == 0)
+        schedule(id);
+
+    JobSystem::Wait(counter);
+  }
+
+  void TaskGraph::Clear() {
+    tasks.clear();
+    validated = false;
+  }
+
+  size_t TaskGraph::Size() const {
+    return tasks.size();
+  }
+
+  void TaskGraph::schedule(const TaskId id) {
+    // Successors are scheduled before the task is marked as finished, the counter can't reach zero too early
+    JobSystem::Schedule(
+      [this, id] {
+        const Task &task = *tasks[id];
+        if (task.job)
+          task.job();
+        for (const TaskId successor: task.successors)
+          if (tasks[successor]->remainingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            schedule(successor);
+      }, &counter
+    );
+  }
+
+  bool TaskGraph::isAcyclic() const {
+    // Kahn's algorithm: the graph is acyclic if every task can be visited in topological order
+    std::vector<size_t> remaining(tasks.size());
+    std::vector<TaskId> ready;
+    for (TaskId id = 0; id < tasks.size(); ++id) {
+      remaining[id] = tasks[id]->dependencyCount;
+      if (remaining[id] == 0)
+        ready.emplace_back(id);
+    }
+
+    size_t visited = 0;
+    while (!ready.empty()) {
+      const TaskId id = ready.back();
+      ready.pop_back();
+      visited++;
+      for (const TaskId successor: tasks[id]->successors)
+        if (--remaining[successor] == 0)
+          ready.emplace_back(successor);
+    }
+    return visited == tasks.size();
+  }
+}
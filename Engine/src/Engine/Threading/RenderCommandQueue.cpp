@@ -0,0 +1,70 @@
+//
+// RenderCommandQueue.cpp
+// Author: Antoine Bastide
+// Date: 16.10.2026
+//
+
+#include "Engine/Threading/RenderCommandQueue.hpp"
+#include "Engine/Macros/Profiling.hpp"
+
+namespace Engine::Threading {
+  RenderCommandQueue::RenderCommandQueue()
+    : head(new Node), tail(head.load(std::memory_order_relaxed)) {}
+
+  RenderCommandQueue::~RenderCommandQueue() {
+    while (tail) {
+      const Node *node = tail;
+      tail = tail->next.load(std::memory_order_relaxed);
+      delete node;
+    }
+  }
+
+  void RenderCommandQueue::Push(RenderCommand command) {
+    const auto node = new Node;
+    node->command = std::move(command);
+
+    // Claim the head first, then link the previous node to this one, the consumer stops at a node that is not linked yet
+    Node *previous = head.exchange(node, std::memory_order_acq_rel);
+    previous->next.store(node, std::memory_order_release);
+  }
+
+  size_t RenderCommandQueue::Drain() {
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSubSystem);
+
+    size_t count = 0;
+    while (Node *next = tail->next.load(std::memory_order_acquire)) {
+      // The executed node becomes the new tail so that producers never link to a deleted node
+      const RenderCommand command = std::move(next->command);
+      delete tail;
+      tail = next;
+      if (command)
+        command();
+      ++count;
+    }
+    return count;
+  }
+
+  size_t RenderCommandQueue::Drain(const std::chrono::steady_clock::duration budget) {
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSubSystem);
+
+    const auto deadline = std::chrono::steady_clock::now() + budget;
+    size_t count = 0;
+    while (Node *next = tail->next.load(std::memory_order_acquire)) {
+      const RenderCommand command = std::move(next->command);
+      delete tail;
+      tail = next;
+      if (command)
+        command();
+      ++count;
+
+      // Commands are not interrupted, so a single slow upload can still exceed the budget
+      if (std::chrono::steady_clock::now() >= deadline)
+        break;
+    }
+    return count;
+  }
+
+  bool RenderCommandQueue::Empty() const {
+    return tail->next.load(std::memory_order_acquire) == nullptr;
+  }
+}
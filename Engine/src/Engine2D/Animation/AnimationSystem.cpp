@@ -6,22 +6,41 @@
 
 #include "Engine2D/Animation/AnimationSystem.hpp"
 #include "Engine/Macros/Profiling.hpp"
+#include "Engine/Threading/JobSystem.hpp"
 #include "Engine2D/Animation/Animator2D.hpp"
 
 namespace Engine2D::Animation {
   void AnimationSystem::addAnimator(Animator2D *animator) {
-    if (animator)
-      animators.emplace_back(animator);
+    if (!animator)
+      return;
+    animator->animationIndex = animators.size();
+    animators.emplace_back(animator);
   }
 
   void AnimationSystem::removeAnimator(Animator2D *animator) {
-    if (animator)
-      std::erase(animators, animator);
+    if (!animator)
+      return;
+
+    // Swap the animator with the last one so that removing it does not shift the whole list
+    const size_t index = animator->animationIndex;
+    if (index >= animators.size() || animators[index] != animator)
+      return;
+    if (index != animators.size() - 1) {
+      animators[index] = animators.back();
+      animators[index]->animationIndex = index;
+    }
+    animators.pop_back();
   }
 
   void AnimationSystem::update() const {
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSystem);
-    for (const auto &animator: animators)
-      animator->update();
+
+    // Animators only write to their own state and to the sprite of their entity
+    Engine::Threading::JobSystem::ParallelFor(
+      animators.size(), 64, [this](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i)
+          animators[i]->update();
+      }
+    );
   }
 }
@@ -16,6 +16,16 @@
 #include "Engine2D/SceneManagement/SceneManager.hpp"
 
 namespace Engine2D::Animation {
+  Animator2D::Animator2D(const Animator2D &other)
+    : Component2D(other), animations(other.animations), parameters(other.parameters), transitions(other.transitions),
+      currentAnimationName(other.currentAnimationName), defaultAnimationName(other.defaultAnimationName) {
+    // The animations were copied, so the pointers of the other animator would point into its map instead of this one
+    if (!defaultAnimationName.empty() && animations.contains(defaultAnimationName))
+      defaultAnimation = &animations.at(defaultAnimationName);
+    if (!currentAnimationName.empty() && animations.contains(currentAnimationName))
+      currentAnimation = &animations.at(currentAnimationName);
+  }
+
   void Animator2D::AddAnimation(const std::string &name, const Animation2D &animation) {
     if (const auto it = animations.find(name); it != animations.end())
       it->second = animation;
@@ -9,10 +9,14 @@
 #include <__ostream/basic_ostream.h>
 
 #include "Engine2D/Entity2D.hpp"
+#include "Engine2D/SceneManagement/Scene.hpp"
 
 namespace Engine2D {
   Component2D::Component2D()
-    : active(true), entity(nullptr) {}
+    : active(true), entity(nullptr), typeId(0), typeIndex(0) {}
+
+  Component2D::Component2D(const Component2D &other)
+    : Reflectable(other), active(other.active), entity(nullptr), typeId(0), typeIndex(0) {}
 
   Engine::Ptr<Entity2D> Component2D::Entity() const {
     return entity;
@@ -23,7 +27,14 @@ namespace Engine2D {
   }
 
   void Component2D::SetActive(const bool active) {
+    if (this->active == active)
+      return;
+
     this->active = active;
+    // Deactivated behaviours are skipped by the dispatch, activated ones are added to it
+    if (active && entity && entity->Scene())
+      if (const auto behaviour = dynamic_cast<Behaviour *>(this))
+        entity->Scene()->queueActivation(behaviour);
   }
 
   bool Component2D::IsActive() const {
@@ -35,10 +46,19 @@ namespace Engine2D {
     if (component.Entity()) {
       os.put(' ');
       os.put('(');
-      os.write(component.Entity()->name.c_str(), component.Entity()->name.size());
+      os.write(component.Entity()->Name().c_str(), component.Entity()->Name().size());
       os.put(')');
     }
     os.put('\n');
     return os;
   }
+
+  uint32_t ComponentType::Id(const std::type_index type) {
+    std::lock_guard lock(mutex);
+    return ids.try_emplace(type, static_cast<uint32_t>(ids.size())).first->second;
+  }
+
+  uint32_t ComponentType::Of(const Component2D &component) {
+    return Id(typeid(component));
+  }
 }
@@ -19,16 +19,24 @@ namespace Engine2D {
     std::string name, const bool isStatic, const glm::vec2 position, const float rotation, const glm::vec2 scale,
     const Engine::Ptr<Entity2D> &parent
   )
-    : name(std::move(name)), active(true), parentsActive(true), isStatic(isStatic), destroyed(false),
-      timeToLive(0.1f), id(0),
+    : name(std::move(name)), nameIndex(0), active(true), parentsActive(true), isStatic(isStatic), destroyed(false),
+      initialized(false), timeToLive(0.1f), id(0),
       transform(std::unique_ptr<Transform2D>(new Transform2D(position, rotation, scale, this, parent))),
-      scene(nullptr) {}
+      behaviourHooks(0), componentMask(0), scene(nullptr) {}
 
   Entity2D::~Entity2D() {
     destroy();
     free();
   }
 
+  void *Entity2D::operator new(size_t) {
+    return Engine::Pool<Entity2D>::Allocate();
+  }
+
+  void Entity2D::operator delete(void *ptr) {
+    Engine::Pool<Entity2D>::Free(ptr);
+  }
+
   bool Entity2D::operator==(const Entity2D &entity) const {
     return id == entity.id;
   }
@@ -41,6 +49,24 @@ namespace Engine2D {
     return transform.get();
   }
 
+  void Entity2D::SetName(const std::string &name) {
+    if (this->name == name)
+      return;
+
+    if (scene)
+      scene->renameEntity(this, name);
+    else
+      this->name = name;
+  }
+
+  const std::string &Entity2D::Name() const {
+    return name;
+  }
+
+  Engine::Handle<Entity2D> Entity2D::Handle() const {
+    return const_cast<Entity2D *>(this);
+  }
+
   uint64_t Entity2D::Id() const {
     return id;
   }
@@ -57,6 +83,7 @@ namespace Engine2D {
     const auto scene = SceneManager::ActiveScene();
     entity->id = nextId++;
     entity->scene = scene;
+    scene->indexName(entity);
     SceneManager::ActiveScene()->entitiesToAdd.emplace_back(std::move(entity));
     return entity;
   }
@@ -70,6 +97,9 @@ namespace Engine2D {
       return;
 
     this->active = active;
+    // The behaviours of deactivated entities are skipped by the dispatch, those of activated ones are added to it
+    if (active && scene)
+      scene->queueActivation(this);
     for (const auto &child: *transform) {
       if (child && child->transform) {
         child->transform->onParentHierarchyChange();
@@ -109,6 +139,7 @@ namespace Engine2D {
     const auto scene = SceneManager::ActiveScene();
     entity->id = nextId++;
     entity->scene = scene;
+    scene->indexName(entity);
     SceneManager::ActiveScene()->entitiesToAddAt.emplace_back(std::move(entity), index);
     return entity;
   }
@@ -123,6 +154,68 @@ namespace Engine2D {
       transform->parent->transform->addChild(this);
       transform->onParentHierarchyChange();
     }
+
+    initialized = true;
+    if (scene && !behavioursToInitialize.empty())
+      scene->entitiesToInitialize.emplace_back(this);
+  }
+
+  void Entity2D::queueInitialization(const Engine::Ptr<Behaviour> &behaviour) {
+    behavioursToInitialize.emplace_back(behaviour);
+    // Entities that are not in their scene yet are queued once they are added to it
+    if (initialized && scene && behavioursToInitialize.size() == 1)
+      scene->entitiesToInitialize.emplace_back(this);
+  }
+
+  void Entity2D::registerComponent(Component2D *component, const uint32_t typeId) {
+    component->typeId = typeId;
+    if (typeId >= componentSlots.size())
+      componentSlots.resize(typeId + 1, nullptr);
+    if (!componentSlots[typeId]) {
+      componentSlots[typeId] = component;
+      if (typeId < 64)
+        componentMask |= 1ull << typeId;
+    }
+    if (scene)
+      scene->registerComponent(component);
+  }
+
+  void Entity2D::unregisterComponent(Component2D *component) {
+    if (scene)
+      scene->unregisterComponent(component);
+
+    const uint32_t typeId = component->typeId;
+    if (typeId >= componentSlots.size() || componentSlots[typeId] != component)
+      return;
+
+    // Hand the slot over to the next component of the same type, if any
+    componentSlots[typeId] = nullptr;
+    for (const auto &other: allComponents)
+      if (other.get() != component && other->typeId == typeId) {
+        componentSlots[typeId] = other.get();
+        break;
+      }
+    if (!componentSlots[typeId] && typeId < 64)
+      componentMask &= ~(1ull << typeId);
+  }
+
+  void Entity2D::addBehaviour(const Engine::Ptr<Behaviour> &behaviour) {
+    behaviours.emplace_back(behaviour);
+    behaviourHooks |= behaviour->hooks;
+    if (scene)
+      scene->dispatchListsDirty = true;
+  }
+
+  void Entity2D::removeBehaviour(const Engine::Ptr<Behaviour> &behaviour) {
+    std::erase(behaviours, behaviour);
+    std::erase(behavioursToInitialize, behaviour);
+
+    behaviourHooks = 0;
+    for (const auto &b: behaviours)
+      behaviourHooks |= b->hooks;
+
+    if (scene)
+      scene->removeFromDispatchLists(behaviour);
   }
 
   void Entity2D::destroy() {
@@ -130,6 +223,10 @@ namespace Engine2D {
       remove();
     for (auto it = allComponents.begin(); it != allComponents.end(); ++it)
       (*it)->recall();
+    if (scene) {
+      scene->unindexEntity(this);
+      scene->entitiesToExpire.insert(this);
+    }
     active = false;
     destroyed = true;
 
@@ -146,9 +243,14 @@ namespace Engine2D {
   }
 
   void Entity2D::free() {
+    if (scene)
+      scene->entitiesToExpire.erase(this);
     allComponents.clear();
     components.clear();
     behaviours.clear();
+    behaviourHooks = 0;
+    componentMask = 0;
+    componentSlots.clear();
     transform.reset();
   }
 
@@ -161,23 +263,36 @@ namespace Engine2D {
 
   void Entity2D::onDeserialize(
     const Engine::Reflection::Format format, const Engine::JSON &json, const Engine::Ptr<Engine2D::Scene> &scene
+  ) {
+    initialized = true;
+    const int index = static_cast<int>(json.At("transform").At("data").At("parent").GetNumber());
+    onDeserialize(format, json, scene, index == -1 ? nullptr : (scene->entities.begin() + index)->get());
+  }
+
+  void Entity2D::onDeserialize(
+    const Engine::Reflection::Format format, const Engine::JSON &json, const Engine::Ptr<Engine2D::Scene> &scene,
+    const Engine::Ptr<Entity2D> &parent
   ) {
     this->scene = scene;
+    scene->indexName(this);
     transform->entity = this;
     transform->SetPositionRotationAndScale(transform->worldPosition, transform->worldRotation, transform->worldScale);
-    const int index = static_cast<int>(json.At("transform").At("data").At("parent").GetNumber());
-    forceSetParent(index == -1 ? nullptr : (scene->entities.begin() + index)->get());
+    forceSetParent(parent);
 
     char *end;
     id = std::strtoull(json.At("id").GetString().c_str(), &end, 10);
-    nextId = id + 1;
+    // Scenes can be deserialized on a background thread while entities are created on the main thread
+    for (uint64_t next = nextId; next <= id && !nextId.compare_exchange_weak(next, id + 1);) {}
 
     std::erase(allComponents, nullptr);
     for (auto &component: allComponents) {
       component->entity = this;
+      registerComponent(component.get(), ComponentType::Of(*component));
       if (const auto behaviour = dynamic_cast<Behaviour *>(component.get()); behaviour) {
-        behaviour->OnBindInput();
-        behaviours.emplace_back(behaviour);
+        // Entities streamed into a running scene initialize their behaviours once they are added to it
+        if (!initialized)
+          queueInitialization(behaviour);
+        addBehaviour(behaviour);
       } else {
         component->forward();
         components.emplace_back(component.get());
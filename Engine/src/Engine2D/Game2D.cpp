@@ -9,11 +9,14 @@
 #include <ranges>
 
 #include "Engine2D/Game2D.hpp"
+#include "Engine/Log.hpp"
 #include "Engine/ResourceManager.hpp"
 #include "Engine/Settings.hpp"
 #include "Engine/Input/Gamepad.hpp"
 #include "Engine/Input/Keyboard.hpp"
 #include "Engine/Input/Mouse.hpp"
+#include "Engine/Profiling/FrameTelemetry.hpp"
+#include "Engine/Threading/JobSystem.hpp"
 #include "Engine2D/Rendering/Renderer2D.hpp"
 #if ENGINE_PROFILING
 #include "Engine/Profiling/Instrumentor.hpp"
@@ -23,6 +26,7 @@
 #include "Engine2D/SceneManagement/SceneManager.hpp"
 
 using Engine::ResourceManager;
+using Engine::Profiling::FrameTelemetry;
 
 namespace Engine2D {
   Game2D::Game2D()
@@ -30,12 +34,9 @@ namespace Engine2D {
 
   Game2D::Game2D(const int width, const int height, const char *title)
     : aspectRatio(glm::vec2(1)), aspectRatioInv(glm::vec2(1)), title(title), width(width), height(height),
-      window(nullptr), deltaTime(0), timeScale(1), targetFrameRate(0), targetRenderRate(0), frameCounter(0),
-      oneSecondTimer(0), physicsAccumulator(0), headlessMode(false)
-      #if MULTI_THREAD
-    , updateFinished(false), renderFinished(true), renderThreadCallback(nullptr), callbackPending(false)
-  #endif
-  {
+      window(nullptr), deltaTime(0), timeScale(1), targetFrameRate(0), targetRenderRate(0), idle(false),
+      headlessMode(false), renderThreadEnabled(false), mainThread(std::this_thread::get_id()), updateFinished(false),
+      renderFinished(true), snapshotIndex(0), renderSnapshot(nullptr) {
     if (instance)
       throw std::runtime_error("ERROR::GAME2D: There can only be one instance of Game2D running.");
     if (width <= 0 || height <= 0)
@@ -76,6 +77,8 @@ namespace Engine2D {
   }
 
   float Game2D::DeltaTime() {
+    if (const auto scene = SceneManager::steppedScene())
+      return scene->deltaTime;
     return instance->deltaTime;
   }
 
@@ -83,6 +86,10 @@ namespace Engine2D {
     return Engine::Settings::Physics::FixedDeltaTime();
   }
 
+  bool Game2D::Idle() {
+    return instance->idle;
+  }
+
   void Game2D::SetGameResourceLoader(ResourceLoader resourceLoader) {
     this->resourceLoader = std::move(resourceLoader);
   }
@@ -104,37 +111,164 @@ namespace Engine2D {
     }
 
     // Set the render variables
-    oneSecondTimer = 0.0f;
     lastTime = std::chrono::steady_clock::now();
     targetFrameRate = Engine::Settings::Graphics::TargetFrameRate();
     targetRenderRate = targetFrameRate == 0 ? 0.0f : 1.0f / targetFrameRate;
-    frameCounter = 0;
 
     initializeGraphicPipeline();
     initializeGamePipeline(instance->window);
+    // Started after the game is initialized so that the threading settings can be changed in OnInitialize
+    initializeThreading();
+
+    if (renderThreadEnabled) {
+      // IMPORTANT:
+      // GLFW requires event processing (glfwPollEvents) in the main thread.
+      // So we run the update loop on the main thread.
+      // We then release the GL context so the render thread can make it current.
+      glfwMakeContextCurrent(nullptr);
+      renderThread = std::thread(&Game2D::renderLoop, this);
+    } else
+      glfwMakeContextCurrent(window);
 
-    #if MULTI_THREAD
-    // IMPORTANT:
-    // GLFW requires event processing (glfwPollEvents) in the main thread.
-    // So we run the update loop on the main thread.
-    // We then release the GL context so the render thread can make it current.
-    glfwMakeContextCurrent(nullptr);
-    renderThread = std::thread(&Game2D::renderLoop, this);
-    #else
-    glfwMakeContextCurrent(window);
+    updateLoop();
+
+    if (renderThread.joinable())
+      renderThread.join();
+
+    quit();
+
+    #ifdef ENGINE_PROFILING
+    Engine::Profiling::Instrumentor::get().endSession();
     #endif
+  }
 
-    updateLoop();
+  HeadlessReport Game2D::RunHeadless(const size_t ticks, const float fixedDeltaTime) {
+    #ifdef ENGINE_PROFILING
+    Engine::Profiling::Instrumentor::get().beginSession("profiler");
+    #endif
+
+    if (!instance) {
+      std::cout << "ERROR::GAME2D::RunHeadless(): Game not initialized!" << std::endl;
+      exit(EXIT_FAILURE);
+    }
+    if (fixedDeltaTime <= 0.0f)
+      throw std::invalid_argument("ERROR::GAME2D: The fixed delta time must be greater than zero");
+
+    // Initialize the game only once so that consecutive runs continue the same simulation
+    if (!headlessMode) {
+      setAsHeadless();
+      initializeGamePipeline(nullptr);
+    }
 
-    #if MULTI_THREAD
-    renderThread.join();
+    HeadlessReport report;
+    report.deltaTime = fixedDeltaTime;
+    report.systems = {{"SyncEntities"}, {"Update"}, {"FixedUpdate"}, {"Animate"}};
+
+    using clock = std::chrono::steady_clock;
+    const auto start = clock::now();
+    for (; report.ticks < ticks; ++report.ticks) {
+      SceneManager::commitLoadedScenes();
+      const auto scene = SceneManager::ActiveScene();
+      if (!scene)
+        break;
+
+      const auto tickStart = clock::now();
+      deltaTime = fixedDeltaTime * timeScale;
+      tickHeadless(*scene, report);
+      FrameTelemetry::endFrame(std::chrono::duration<float, std::milli>(clock::now() - tickStart).count());
+    }
+    report.seconds = std::chrono::duration<double>(clock::now() - start).count();
+
+    #ifdef ENGINE_PROFILING
+    Engine::Profiling::Instrumentor::get().endSession();
     #endif
 
-    quit();
+    return report;
+  }
+
+  std::vector<HeadlessReport> Game2D::RunHeadless(
+    const std::vector<Engine::Ptr<Scene>> &scenes, const size_t ticks, const float fixedDeltaTime
+  ) {
+    #ifdef ENGINE_PROFILING
+    Engine::Profiling::Instrumentor::get().beginSession("profiler");
+    #endif
+
+    if (!instance) {
+      std::cout << "ERROR::GAME2D::RunHeadless(): Game not initialized!" << std::endl;
+      exit(EXIT_FAILURE);
+    }
+    if (fixedDeltaTime <= 0.0f)
+      throw std::invalid_argument("ERROR::GAME2D: The fixed delta time must be greater than zero");
+
+    if (!headlessMode) {
+      setAsHeadless();
+      initializeGamePipeline(nullptr);
+    }
+    SceneManager::commitLoadedScenes();
+
+    // Each scene is stepped by a single job, the jobs its systems schedule are run with the same active scene
+    std::vector<HeadlessReport> reports(scenes.size());
+    Engine::Threading::JobSystem::ParallelFor(
+      scenes.size(), 1, [&](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          if (!scenes[i])
+            continue;
+
+          Scene &scene = *scenes[i];
+          SceneManager::ScopedScene scope(scenes[i]);
+          if (!scene.loaded)
+            scene.initialize();
+
+          HeadlessReport &report = reports[i];
+          report.deltaTime = fixedDeltaTime;
+          report.systems = {{"SyncEntities"}, {"Update"}, {"FixedUpdate"}, {"Animate"}};
+
+          using clock = std::chrono::steady_clock;
+          const auto start = clock::now();
+          for (; report.ticks < ticks; ++report.ticks) {
+            scene.deltaTime = fixedDeltaTime * timeScale;
+            tickHeadless(scene, report);
+          }
+          report.seconds = std::chrono::duration<double>(clock::now() - start).count();
+        }
+      }
+    );
 
     #ifdef ENGINE_PROFILING
     Engine::Profiling::Instrumentor::get().endSession();
     #endif
+
+    return reports;
+  }
+
+  void Game2D::tickHeadless(Scene &scene, HeadlessReport &report) {
+    using clock = std::chrono::steady_clock;
+    const auto measure = [](HeadlessReport::System &system, const auto &function) {
+      const auto start = clock::now();
+      function();
+      system.seconds += std::chrono::duration<double>(clock::now() - start).count();
+    };
+
+    measure(
+      report.systems[0], [&scene] {
+        scene.syncEntities();
+      }
+    );
+    measure(
+      report.systems[1], [&scene] {
+        scene.update();
+      }
+    );
+    measure(
+      report.systems[2], [&scene] {
+        scene.fixedUpdate();
+      }
+    );
+    measure(
+      report.systems[3], [&scene] {
+        scene.animate();
+      }
+    );
   }
 
   void Game2D::initializeGraphicPipeline() {
@@ -169,6 +303,9 @@ namespace Engine2D {
     glfwMakeContextCurrent(window);
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
     glfwSetScrollCallback(window, scroll_callback);
+    glfwSetKeyCallback(window, key_callback);
+    glfwSetCursorPosCallback(window, cursor_position_callback);
+    glfwSetMouseButtonCallback(window, mouse_button_callback);
 
     glfwSwapInterval(Engine::Settings::Graphics::VsyncEnabled());
 
@@ -199,18 +336,22 @@ namespace Engine2D {
   }
 
   void Game2D::initializeGamePipeline(GLFWwindow *window) {
-    Engine::Input::Mouse::initialize(window);
-    Engine::Input::Keyboard::initialize(window);
+    if (window) {
+      Engine::Input::Mouse::initialize(window);
+      Engine::Input::Keyboard::initialize(window);
+    }
 
     // Create the default scene
     SceneManager::CreateScene("default");
     SceneManager::SetActiveScene("default");
 
-    // Set up the shader preprocessor and load the engine shaders
-    int textureCount = 0;
-    glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &textureCount);
-    Rendering::Renderer2D::MAX_TEXTURES = textureCount;
-    ResourceManager::LoadShader("sprite", "Engine/Shaders/sprite.glsl");
+    // Set up the shader preprocessor and load the engine shaders, only possible with an OpenGL context
+    if (window) {
+      int textureCount = 0;
+      glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &textureCount);
+      Rendering::Renderer2D::MAX_TEXTURES = textureCount;
+      ResourceManager::LoadShader("sprite", "Engine/Shaders/sprite.glsl");
+    }
 
     // Initialize timing
     lastTime = std::chrono::steady_clock::now();
@@ -222,65 +363,75 @@ namespace Engine2D {
   void Game2D::updateLoop() {
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerThread);
 
+    lastInputTime = std::chrono::steady_clock::now();
     while (!glfwWindowShouldClose(window)) {
+      // Sleep until the next idle frame instead of polling, the game wakes up once it is focused or receives input
+      if (updateIdleState())
+        waitWhileIdle();
+
       // Calculate the current deltaTime
       const auto currentFrameTime = std::chrono::high_resolution_clock::now();
       deltaTime = std::chrono::duration<float>(currentFrameTime - lastTime).count() * timeScale;
       lastTime = currentFrameTime;
-      glfwPollEvents();
+      {
+        FrameTelemetry::ScopedStage stage(FrameTelemetry::Input);
+        glfwPollEvents();
+        processInput();
+      }
+
+      // Scenes loaded in the background are added between frames, by the thread that updates them
+      SceneManager::commitLoadedScenes();
+      // Without a render thread, this thread owns the context and runs the commands queued by the loading threads
+      if (!renderThreadEnabled)
+        drainRenderCommands();
 
-      processInput();
       if (const auto scene = SceneManager::ActiveScene(); scene) {
         scene->syncEntities();
         scene->update();
         scene->fixedUpdate();
         scene->animate();
-        #if !MULTI_THREAD
-        scene->render();
-        #endif
+        if (renderThreadEnabled)
+          scene->extractFrame(frameSnapshots[snapshotIndex]);
+        else
+          scene->render();
+      } else if (renderThreadEnabled) {
+        frameSnapshots[snapshotIndex].scene = nullptr;
+        frameSnapshots[snapshotIndex].empty = true;
       }
 
-      #if MULTI_THREAD
-      // Handoff engine data to the render thread
-      {
-        std::unique_lock lock(syncMutex);
-        cv.wait(
-          lock, [this] {
-            return renderFinished;
-          }
-        );
-        updateFinished = true;
-        renderFinished = false;
+      if (renderThreadEnabled) {
+        // Handoff the extracted frame to the render thread, the next frame can then be updated while this one is drawn
+        {
+          std::unique_lock lock(syncMutex);
+          cv.wait(
+            lock, [this] {
+              return renderFinished;
+            }
+          );
+          renderSnapshot = &frameSnapshots[snapshotIndex];
+          snapshotIndex = 1 - snapshotIndex;
+          updateFinished = true;
+          renderFinished = false;
+        }
+        cv.notify_one();
       }
-      cv.notify_one();
-      #endif
 
-      // FPS calculation
-      frameCounter++;
       limitFrameRate();
-      oneSecondTimer += deltaTime;
-      while (oneSecondTimer >= 1.0f) {
-        const std::string fpsString = std::to_string(frameCounter);
-        std::cout.write("FPS: ", 5);
-        std::cout.write(fpsString.c_str(), fpsString.length());
-        std::cout.put('\n');
-        oneSecondTimer -= 1.0f;
-        frameCounter = 0;
-        physicsAccumulator = 0.0f;
-      }
+      FrameTelemetry::endFrame(
+        std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - currentFrameTime).count()
+      );
     }
 
-    #if MULTI_THREAD
     // In case the window is closing, ensure the render thread isn’t left waiting.
-    {
-      std::unique_lock lock(syncMutex);
-      updateFinished = true;
+    if (renderThreadEnabled) {
+      {
+        std::unique_lock lock(syncMutex);
+        updateFinished = true;
+      }
+      cv.notify_one();
     }
-    cv.notify_one();
-    #endif
   }
 
-  #if MULTI_THREAD
   void Game2D::renderLoop() {
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerThread);
 
@@ -293,34 +444,106 @@ namespace Engine2D {
 
     // Make the GL context current in this thread.
     glfwMakeContextCurrent(window);
+    if (const auto &cores = Engine::Settings::Threading::Affinity(); !cores.empty())
+      if (const uint core = cores[1 % cores.size()]; !Engine::Threading::JobSystem::PinCurrentThread(core))
+        Engine::Log::Warning("Could not pin the render thread to core " + std::to_string(core));
 
     while (!glfwWindowShouldClose(window)) {
       std::unique_lock lock(syncMutex);
       cv.wait(
         lock, [this] {
-          return updateFinished || callbackPending;
+          return updateFinished || !renderCommands.Empty();
         }
       );
 
-      // Run render thread callback
-      if (callbackPending && renderThreadCallback) {
-        renderThreadCallback();
-        renderThreadCallback = nullptr;
-        callbackPending = false;
-        controlCV.notify_one();
+      // The snapshot is exclusively ours until the next handoff, so the update thread can keep running
+      const bool frameReady = updateFinished;
+      const Rendering::FrameSnapshot *snapshot = renderSnapshot;
+      updateFinished = false;
+      lock.unlock();
+
+      // Commands run before the frame is drawn so that the resources they upload can be used by it, the ones that do
+      // not fit in the budget wake this thread up again right away and run in slices until the next frame is ready
+      drainRenderCommands();
+      if (!frameReady)
         continue;
-      }
 
-      // Now the engine data is exclusively ours; render the frame.
-      if (SceneManager::ActiveScene())
-        SceneManager::ActiveScene()->render();
+      // The snapshot is drawn by the scene it was extracted from, which is kept alive until the frame is finished
+      if (snapshot && snapshot->scene)
+        snapshot->scene->render(*snapshot);
 
-      updateFinished = false;
+      lock.lock();
       renderFinished = true;
+      lock.unlock();
       cv.notify_one();
     }
+
+    // Run the commands queued while the window was closing so that no caller waits on them forever
+    renderCommands.Drain();
+    glfwMakeContextCurrent(nullptr);
+
+    // A frame handed off while the window was closing is never drawn, release the scenes waiting on it
+    {
+      std::lock_guard lock(syncMutex);
+      renderFinished = true;
+    }
+    cv.notify_all();
+  }
+
+  void Game2D::waitForRenderedFrame() {
+    if (!instance || !instance->renderThreadEnabled || !instance->renderThread.joinable())
+      return;
+    if (std::this_thread::get_id() == instance->renderThread.get_id())
+      return;
+
+    std::unique_lock lock(instance->syncMutex);
+    instance->cv.wait(
+      lock, [] {
+        return instance->renderFinished;
+      }
+    );
+  }
+
+  void Game2D::wakeRenderThread() {
+    // Lock the mutex to prevent the wake-up from being lost while the render thread is about to wait
+    { std::lock_guard lock(syncMutex); }
+    cv.notify_all();
+  }
+
+  void Game2D::drainRenderCommands() {
+    using namespace std::chrono;
+    if (const float budget = Engine::Settings::Graphics::RenderCommandBudget(); budget > 0.0f)
+      renderCommands.Drain(duration_cast<steady_clock::duration>(duration<float, std::milli>(budget)));
+    else
+      renderCommands.Drain();
+  }
+
+  void Game2D::initializeThreading() {
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerFunction);
+
+    using Threading = Engine::Settings::Threading;
+    const auto model = Threading::ThreadingModel();
+    renderThreadEnabled = !headlessMode && model != Threading::Model::SingleThread;
+
+    size_t workerCount = 0;
+    if (model == Threading::Model::WorkerPool) {
+      workerCount = Threading::WorkerCount();
+      if (workerCount == 0)
+        workerCount = Engine::Threading::JobSystem::DefaultWorkerCount(renderThreadEnabled ? 2 : 1);
+    }
+
+    // The update thread takes the first core, the render thread the second one and the workers the next ones
+    std::vector<uint> workerCores;
+    if (const auto &cores = Threading::Affinity(); !cores.empty()) {
+      if (!Engine::Threading::JobSystem::PinCurrentThread(cores[0]))
+        Engine::Log::Warning("Could not pin the update thread to core " + std::to_string(cores[0]));
+      const size_t firstWorkerCore = renderThreadEnabled ? 2 : 1;
+      for (size_t i = 0; i < workerCount; ++i)
+        workerCores.emplace_back(cores[(firstWorkerCore + i) % cores.size()]);
+    }
+
+    Engine::Threading::JobSystem::Initialize(workerCount, workerCores);
   }
-  #endif
 
   void Game2D::processInput() {
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSubSystem);
@@ -338,7 +561,8 @@ namespace Engine2D {
 
     using namespace std::chrono;
 
-    if (Engine::Settings::Graphics::VsyncEnabled())
+    // The idle frame rate is enforced while waiting for events
+    if (Engine::Settings::Graphics::VsyncEnabled() || idle)
       return;
 
     static auto nextFrameTime = steady_clock::now();
@@ -353,9 +577,48 @@ namespace Engine2D {
       nextFrameTime = now;
   }
 
+  bool Game2D::updateIdleState() {
+    using Graphics = Engine::Settings::Graphics;
+
+    const bool unfocused = !glfwGetWindowAttrib(window, GLFW_FOCUSED) || glfwGetWindowAttrib(window, GLFW_ICONIFIED);
+    const float timeout = Graphics::IdleTimeout();
+    const float sinceLastInput = std::chrono::duration<float>(std::chrono::steady_clock::now() - lastInputTime).count();
+    const bool inactive = timeout > 0.0f && sinceLastInput >= timeout;
+
+    idle = (Graphics::IdleWhenUnfocused() && unfocused) || inactive;
+    return idle;
+  }
+
+  void Game2D::waitWhileIdle() {
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerFunction);
+
+    using namespace std::chrono;
+
+    const auto nextFrameTime = lastTime + duration_cast<steady_clock::duration>(
+                                 duration<double>(1.0 / Engine::Settings::Graphics::IdleFrameRate())
+                               );
+
+    // Events that do not end the idle state, such as the cursor moving over an unfocused window, keep the game asleep
+    while (idle && !glfwWindowShouldClose(window)) {
+      const double remaining = duration<double>(nextFrameTime - steady_clock::now()).count();
+      if (remaining <= 0.0)
+        break;
+      glfwWaitEventsTimeout(remaining);
+      updateIdleState();
+    }
+  }
+
   void Game2D::quit() {
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerFunction);
 
+    // Finish all the pending jobs before deallocating the resources they might use
+    Engine::Threading::JobSystem::Shutdown();
+
+    // The render thread has exited, the GPU resources are freed from this thread
+    renderThreadEnabled = false;
+    if (window)
+      glfwMakeContextCurrent(window);
+
     // Deallocate all the game resources
     SceneManager::DestroyAllScenes();
     ResourceManager::Clear();
@@ -401,10 +664,23 @@ namespace Engine2D {
   }
 
   void Game2D::scroll_callback(GLFWwindow *, double, const double yOffset) {
+    instance->lastInputTime = std::chrono::steady_clock::now();
     if (Engine::Settings::Input::AllowMouseInput())
       Engine::Input::Mouse::processScroll(yOffset);
   }
 
+  void Game2D::key_callback(GLFWwindow *, int, int, int, int) {
+    instance->lastInputTime = std::chrono::steady_clock::now();
+  }
+
+  void Game2D::cursor_position_callback(GLFWwindow *, double, double) {
+    instance->lastInputTime = std::chrono::steady_clock::now();
+  }
+
+  void Game2D::mouse_button_callback(GLFWwindow *, int, int, int) {
+    instance->lastInputTime = std::chrono::steady_clock::now();
+  }
+
   void Game2D::window_close_callback(GLFWwindow *) {
     Quit();
   }
@@ -415,8 +691,10 @@ namespace Engine2D {
 
     // Calculate delta time
     const auto currentFrameTime = std::chrono::high_resolution_clock::now();
-    deltaTime = std::chrono::duration<float>(currentFrameTime - lastTime).count() * timeScale;
+    const float frameTime = std::chrono::duration<float>(currentFrameTime - lastTime).count();
+    deltaTime = frameTime * timeScale;
     lastTime = currentFrameTime;
+    SceneManager::commitLoadedScenes();
 
     // Update the active scene
     if (const auto scene = SceneManager::ActiveScene(); scene) {
@@ -425,6 +703,7 @@ namespace Engine2D {
       scene->fixedUpdate();
       scene->animate();
     }
+    FrameTelemetry::endFrame(frameTime * 1000.0f);
   }
 
   void Game2D::renderFrame() const {
@@ -439,5 +718,6 @@ namespace Engine2D {
 
   void Game2D::setAsHeadless() {
     headlessMode = true;
+    initializeThreading();
   }
 }
@@ -86,18 +86,30 @@ namespace Engine2D {
     Entity()->Scene()->particleSystemRegistry.removeParticleSystem(this);
   }
 
-  void ParticleSystem2D::updateAndRender(const uint textureIndex, float *data) {
+  void ParticleSystem2D::updateAndRender(const uint textureIndex, float *data, const int instanceCount) {
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSystem);
 
+    // Hide the instances that were not written to, the buffer may contain the data of a previous frame
+    int j = 0;
+    const auto hideUnusedInstances = [&] {
+      for (int i = j; i < instanceCount; ++i) {
+        data[i * STRIDE + 2] = 0.0f;
+        data[i * STRIDE + 3] = 0.0f;
+      }
+    };
+
     // Make sure we can update and render the particles
     if (const bool canUpdateAndRender = Game2D::Initialized() && SceneManager::ActiveScene()->MainCamera(); !
       canUpdateAndRender) {
       simulationFinished = false;
+      hideUnusedInstances();
       return;
     }
 
-    if ((!restart && !loop && simulationFinished) || duration == 0 || maxParticles == 0)
+    if ((!restart && !loop && simulationFinished) || duration == 0 || maxParticles == 0) {
+      hideUnusedInstances();
       return;
+    }
 
     if (restart) {
       restart = false;
@@ -106,8 +118,10 @@ namespace Engine2D {
 
     const float deltaTime = Game2D::DeltaTime();
     durationAcc += deltaTime;
-    if (!loop && durationAcc < startDelay)
+    if (!loop && durationAcc < startDelay) {
+      hideUnusedInstances();
       return;
+    }
 
     if (loop || durationAcc <= duration + startDelay) {
       emissionAcc += emissionRate * deltaTime;
@@ -125,9 +139,10 @@ namespace Engine2D {
     const glm::vec2 scaleDelta = startScale - endScale;
     const float angularVelDelta = endAngularVelocity - startAngularVelocity;
     const Engine::Rendering::Color colorDelta = endColor - startColor;
+    const Affine2D localToWorld = Transform()->WorldMatrix();
 
-    int j = 0;
-    for (int i = 0; i < capacity; ++i) {
+    // Only the instances reserved by the renderer can be written, particles spawned this frame may not fit
+    for (int i = 0; i < capacity && j < instanceCount; ++i) {
       int index = head + capacity - 1 - i;
       if (index >= maxParticles)
         index -= maxParticles;
@@ -145,15 +160,10 @@ namespace Engine2D {
       rotation += dt * (startAngularVelocity + angularVelDelta * t);
       scale = endScale + scaleDelta * t;
 
-      if (lifeTime <= 0.0f && !cam.IsInViewport(position, scale))
+      const glm::vec2 pos = simulateInWorldSpace ? position : localToWorld.TransformPoint(position);
+      if (lifeTime <= 0.0f && !cam.IsInViewport(pos, scale))
         continue;
 
-      glm::vec2 pos;
-      if (simulateInWorldSpace)
-        pos = position;
-      else
-        pos = glm::vec2(Transform()->WorldMatrix() * glm::vec4(position, 0, 1));
-
       const int idx = j * STRIDE;
       const float inversePPU = 1.0f / sprite->pixelsPerUnit;
       const float tOpp = 1.0f - lifeTime * inverseLifetime;
@@ -187,6 +197,7 @@ namespace Engine2D {
 
       j++;
     }
+    hideUnusedInstances();
 
     // Remove dead particles
     while (capacity > 0) {
@@ -205,7 +216,8 @@ namespace Engine2D {
     simulationFinished = !loop && durationAcc > duration + startDelay && capacity == 0;
   }
 
-  static std::mt19937 gen(std::random_device{}());
+  // Particle systems are simulated in parallel by the renderer, each thread needs its own generator
+  static thread_local std::mt19937 gen(std::random_device{}());
 
   void ParticleSystem2D::respawnParticle() {
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerFunction);
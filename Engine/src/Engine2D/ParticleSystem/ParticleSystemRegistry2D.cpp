@@ -80,14 +80,14 @@ namespace Engine2D {
   void ParticleSystemRegistry2D::addParticleSystem(ParticleSystem2D *particleSystem) {
     if (!particleSystem)
       return;
-    scene->resources.renderables.push_back(particleSystem);
+    scene->resources.addRenderable(particleSystem);
     particleSystemsToAdd.emplace_back(particleSystem);
   }
 
   void ParticleSystemRegistry2D::removeParticleSystem(ParticleSystem2D *particleSystem) {
     if (!particleSystem)
       return;
-    std::erase(scene->resources.renderables, particleSystem);
+    scene->resources.removeRenderable(particleSystem);
     particleSystemsToRemove.insert(particleSystem);
   }
 } // Engine2D
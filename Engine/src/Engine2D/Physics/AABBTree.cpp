@@ -0,0 +1,236 @@
+//
+// AABBTree.cpp
+// Author: Antoine Bastide
+// Date: 16.10.2026
+//
+
+#include <algorithm>
+
+#include "Engine2D/Physics/AABBTree.hpp"
+#include "Engine/Macros/Profiling.hpp"
+
+/// The margin added on each side of the bounds of a leaf, as a fraction of their size
+#define AABB_TREE_MARGIN 0.1f
+
+namespace Engine2D::Physics {
+  AABBTree::AABBTree()
+    : root(-1), freeList(-1), leafCount(0) {}
+
+  int32_t AABBTree::createLeaf(const Collider2D::AABB &aabb, const uint32_t index) {
+    const int32_t leaf = allocateNode();
+    nodes[leaf].aabb = fatten(aabb);
+    nodes[leaf].index = index;
+    insertLeaf(leaf);
+    ++leafCount;
+    return leaf;
+  }
+
+  void AABBTree::destroyLeaf(const int32_t leaf) {
+    removeLeaf(leaf);
+    freeNode(leaf);
+    --leafCount;
+  }
+
+  bool AABBTree::moveLeaf(const int32_t leaf, const Collider2D::AABB &aabb, const uint32_t index) {
+    nodes[leaf].index = index;
+    if (contains(nodes[leaf].aabb, aabb))
+      return false;
+
+    removeLeaf(leaf);
+    nodes[leaf].aabb = fatten(aabb);
+    insertLeaf(leaf);
+    return true;
+  }
+
+  void AABBTree::clear() {
+    nodes.clear();
+    root = -1;
+    freeList = -1;
+    leafCount = 0;
+  }
+
+  bool AABBTree::empty() const {
+    return leafCount == 0;
+  }
+
+  int32_t AABBTree::allocateNode() {
+    int32_t node = freeList;
+    if (node == -1) {
+      node = static_cast<int32_t>(nodes.size());
+      nodes.emplace_back();
+    } else
+      freeList = nodes[node].parent;
+
+    nodes[node] = Node{};
+    return node;
+  }
+
+  void AABBTree::freeNode(const int32_t node) {
+    nodes[node].parent = freeList;
+    nodes[node].height = -1;
+    freeList = node;
+  }
+
+  void AABBTree::insertLeaf(const int32_t leaf) {
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerFunction);
+
+    if (root == -1) {
+      root = leaf;
+      nodes[leaf].parent = -1;
+      return;
+    }
+
+    // Go down the tree towards the child whose bounds grow the least, until making the leaf the sibling of the
+    // current node is cheaper than pushing it further down
+    const Collider2D::AABB aabb = nodes[leaf].aabb;
+    int32_t sibling = root;
+    while (!nodes[sibling].isLeaf()) {
+      const Node &node = nodes[sibling];
+      const float area = perimeter(node.aabb);
+      const float combinedArea = perimeter(combine(node.aabb, aabb));
+      const float cost = 2.0f * combinedArea;
+      // Every node below this one will also have to contain the leaf
+      const float inheritanceCost = 2.0f * (combinedArea - area);
+
+      const auto descentCost = [&](const int32_t child) {
+        const float childArea = perimeter(combine(nodes[child].aabb, aabb));
+        return (nodes[child].isLeaf() ? childArea : childArea - perimeter(nodes[child].aabb)) + inheritanceCost;
+      };
+      const float leftCost = descentCost(node.left);
+      const float rightCost = descentCost(node.right);
+      if (cost < leftCost && cost < rightCost)
+        break;
+      sibling = leftCost < rightCost ? node.left : node.right;
+    }
+
+    // Create a new parent for the sibling and the leaf
+    const int32_t oldParent = nodes[sibling].parent;
+    const int32_t newParent = allocateNode();
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].aabb = combine(aabb, nodes[sibling].aabb);
+    nodes[newParent].height = nodes[sibling].height + 1;
+    nodes[newParent].left = sibling;
+    nodes[newParent].right = leaf;
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    if (oldParent == -1)
+      root = newParent;
+    else if (nodes[oldParent].left == sibling)
+      nodes[oldParent].left = newParent;
+    else
+      nodes[oldParent].right = newParent;
+
+    refit(newParent);
+  }
+
+  void AABBTree::removeLeaf(const int32_t leaf) {
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerFunction);
+
+    if (leaf == root) {
+      root = -1;
+      return;
+    }
+
+    const int32_t parent = nodes[leaf].parent;
+    const int32_t grandParent = nodes[parent].parent;
+    const int32_t sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+
+    // The sibling takes the place of the parent
+    nodes[sibling].parent = grandParent;
+    freeNode(parent);
+    if (grandParent == -1) {
+      root = sibling;
+      return;
+    }
+
+    if (nodes[grandParent].left == parent)
+      nodes[grandParent].left = sibling;
+    else
+      nodes[grandParent].right = sibling;
+    refit(grandParent);
+  }
+
+  int32_t AABBTree::balance(const int32_t node) {
+    Node &a = nodes[node];
+    if (a.isLeaf() || a.height < 2)
+      return node;
+
+    const int32_t b = a.left;
+    const int32_t c = a.right;
+    const int32_t difference = nodes[c].height - nodes[b].height;
+    if (difference >= -1 && difference <= 1)
+      return node;
+
+    // The highest child takes the place of the node, which takes the place of the highest grandchild
+    const int32_t up = difference > 0 ? c : b;
+    const int32_t other = difference > 0 ? b : c;
+    Node &upNode = nodes[up];
+    const int32_t f = upNode.left;
+    const int32_t g = upNode.right;
+
+    upNode.left = node;
+    upNode.parent = a.parent;
+    a.parent = up;
+    if (upNode.parent == -1)
+      root = up;
+    else if (nodes[upNode.parent].left == node)
+      nodes[upNode.parent].left = up;
+    else
+      nodes[upNode.parent].right = up;
+
+    // The node keeps the lowest grandchild, the highest one stays under the child that moved up
+    const int32_t kept = nodes[f].height > nodes[g].height ? f : g;
+    const int32_t given = kept == f ? g : f;
+    upNode.right = kept;
+    if (difference > 0)
+      a.right = given;
+    else
+      a.left = given;
+    nodes[given].parent = node;
+
+    a.aabb = combine(nodes[other].aabb, nodes[given].aabb);
+    a.height = 1 + std::max(nodes[other].height, nodes[given].height);
+    upNode.aabb = combine(a.aabb, nodes[kept].aabb);
+    upNode.height = 1 + std::max(a.height, nodes[kept].height);
+    return up;
+  }
+
+  void AABBTree::refit(int32_t node) {
+    while (node != -1) {
+      node = balance(node);
+      Node &current = nodes[node];
+      current.aabb = combine(nodes[current.left].aabb, nodes[current.right].aabb);
+      current.height = 1 + std::max(nodes[current.left].height, nodes[current.right].height);
+      node = current.parent;
+    }
+  }
+
+  Collider2D::AABB AABBTree::fatten(const Collider2D::AABB &aabb) {
+    const glm::vec2 margin = (aabb.max - aabb.min) * AABB_TREE_MARGIN;
+    Collider2D::AABB result;
+    result.min = aabb.min - margin;
+    result.max = aabb.max + margin;
+    return result;
+  }
+
+  Collider2D::AABB AABBTree::combine(const Collider2D::AABB &a, const Collider2D::AABB &b) {
+    Collider2D::AABB result;
+    result.min = glm::min(a.min, b.min);
+    result.max = glm::max(a.max, b.max);
+    return result;
+  }
+
+  float AABBTree::perimeter(const Collider2D::AABB &aabb) {
+    const glm::vec2 size = aabb.max - aabb.min;
+    return 2.0f * (size.x + size.y);
+  }
+
+  bool AABBTree::contains(const Collider2D::AABB &a, const Collider2D::AABB &b) {
+    return a.min.x <= b.min.x && a.min.y <= b.min.y && b.max.x <= a.max.x && b.max.y <= a.max.y;
+  }
+
+  bool AABBTree::overlaps(const Collider2D::AABB &a, const Collider2D::AABB &b) {
+    return a.min.x <= b.max.x && b.min.x <= a.max.x && a.min.y <= b.max.y && b.min.y <= a.max.y;
+  }
+}
@@ -13,11 +13,17 @@
 #include "Engine2D/Physics/Physics2D.hpp"
 #include "Engine2D/Physics/Rigidbody2D.hpp"
 #include "Engine2D/SceneManagement/SceneManager.hpp"
+#include "Engine2D/Types/Affine2D.hpp"
 
 namespace Engine2D::Physics {
   Collider2D::Collider2D()
     : elasticity(1), positionOffset(glm::vec2(0)), isTrigger(false), autoCompute(true), position(glm::vec2(0)),
-      type(None), initialized(false), lastModelMatrix(), rigidbody() {}
+      type(None), transformVersion(0), rigidbody(), physicsIndex(0), treeProxy(-1) {}
+
+  Collider2D::Collider2D(const Collider2D &other)
+    : Component2D(other), ICustomEditor(other), elasticity(other.elasticity), positionOffset(other.positionOffset),
+      isTrigger(other.isTrigger), autoCompute(other.autoCompute), position(other.position), type(other.type),
+      vertices(other.vertices), transformVersion(0), rigidbody(), physicsIndex(0), treeProxy(-1) {}
 
   void Collider2D::forward() {
     Entity()->Scene()->physicsSystem.addCollider(this);
@@ -42,14 +48,12 @@ namespace Engine2D::Physics {
   #endif
 
   Collider2D::AABB Collider2D::getAABB() {
-    const auto matrix = Transform()->WorldMatrix();
-    if (!rigidbody)
-      rigidbody = Entity()->GetComponent<Rigidbody2D>();
-    if (initialized && lastModelMatrix == matrix)
+    // A transform waiting to be propagated has not been given its new version yet
+    const auto transform = Transform();
+    if (transformVersion == transform->version && !transform->worldOutdated())
       return aabb;
 
-    initialized = true;
-    lastModelMatrix = matrix;
+    transformVersion = transform->version;
     computeAABB();
     return aabb;
   }
@@ -118,12 +122,13 @@ namespace Engine2D::Physics {
     const float top = autoCompute ? Transform()->WorldHalfScale().y : size.y;
     const float bottom = -top;
 
-    // Transform the bounds of the rectangle
+    // Transform the bounds of the rectangle, the rotation is computed once for all the corners
+    const auto matrix = Affine2D::TRS(getPosition(), glm::radians(Transform()->WorldRotation()), glm::vec2(1.0f));
     this->transformedVertices = {
-      glm::rotate(glm::vec2(left, top), glm::radians(Transform()->WorldRotation())) + getPosition(),
-      glm::rotate(glm::vec2(right, top), glm::radians(Transform()->WorldRotation())) + getPosition(),
-      glm::rotate(glm::vec2(right, bottom), glm::radians(Transform()->WorldRotation())) + getPosition(),
-      glm::rotate(glm::vec2(left, bottom), glm::radians(Transform()->WorldRotation())) + getPosition(),
+      matrix.TransformPoint(glm::vec2(left, top)),
+      matrix.TransformPoint(glm::vec2(right, top)),
+      matrix.TransformPoint(glm::vec2(right, bottom)),
+      matrix.TransformPoint(glm::vec2(left, bottom)),
     };
 
     // Construct the AABB
@@ -170,10 +175,10 @@ namespace Engine2D::Physics {
     }
 
     // Transform the bounds of the rectangle
+    const auto matrix = Affine2D::TRS(getPosition(), glm::radians(Transform()->WorldRotation()), glm::vec2(1.0f));
     this->transformedVertices.resize(vertices.size());
     for (size_t i = 0; i < vertices.size(); ++i)
-      this->transformedVertices[i] = glm::rotate(vertices[i], glm::radians(Transform()->WorldRotation())) +
-                                     getPosition();
+      this->transformedVertices[i] = matrix.TransformPoint(vertices[i]);
 
     // Construct the AABB
     aabb.min = glm::vec2(1) * std::numeric_limits<float>::max();
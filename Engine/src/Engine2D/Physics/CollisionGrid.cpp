@@ -7,7 +7,6 @@
 #include "Engine2D/Physics/CollisionGrid.hpp"
 #include "Engine/Macros/Profiling.hpp"
 #include "Engine2D/Game2D.hpp"
-#include "Engine2D/Physics/Collider2D.hpp"
 
 namespace Engine2D::Physics {
   CollisionGrid::CollisionGrid()
@@ -18,7 +17,7 @@ namespace Engine2D::Physics {
     this->topRight = -bottomLeft;
     this->gridSize = gridSize;
     this->cellSize = glm::vec2(Game2D::ViewportWidth() / gridSize.x, Game2D::ViewportHeight() / gridSize.y);
-    grid.resize(gridSize.x, std::vector<std::vector<Engine::Ptr<Collider2D>>>(gridSize.y));
+    grid.resize(gridSize.x, std::vector<std::vector<uint32_t>>(gridSize.y));
   }
 
   void CollisionGrid::setGridSize(const glm::vec<2, size_t> gridSize) {
@@ -28,10 +27,10 @@ namespace Engine2D::Physics {
     for (auto &col: grid)
       for (auto &cell: col)
         cell.clear();
-    grid.resize(gridSize.x, std::vector<std::vector<Engine::Ptr<Collider2D>>>(gridSize.y));
+    grid.resize(gridSize.x, std::vector<std::vector<uint32_t>>(gridSize.y));
   }
 
-  void CollisionGrid::update(const std::vector<Engine::Ptr<Collider2D>> &colliders) {
+  void CollisionGrid::update(const std::vector<Collider2D::AABB> &aabbs) {
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSubSystem);
 
     // Clear the cells
@@ -39,8 +38,8 @@ namespace Engine2D::Physics {
       for (auto &cell: col)
         cell.clear();
 
-    for (const auto &collider: colliders) {
-      const auto [min, max] = collider->getAABB();
+    for (uint32_t i = 0; i < aabbs.size(); ++i) {
+      const auto &[min, max] = aabbs[i];
 
       const int xBodyMin = std::clamp(
         static_cast<int>(std::floor((min.x - bottomLeft.x) / cellSize.x)), 0, static_cast<int>(gridSize.x) - 1
@@ -57,7 +56,7 @@ namespace Engine2D::Physics {
 
       for (int x = xBodyMin; x <= xBodyMax; ++x)
         for (int y = yBodyMin; y <= yBodyMax; ++y)
-          grid[x][y].push_back(collider);
+          grid[x][y].push_back(i);
     }
   }
 }
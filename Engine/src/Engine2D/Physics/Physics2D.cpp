@@ -13,17 +13,20 @@
 #include "Engine2D/Physics/Physics2D.hpp"
 #include "Engine/Settings.hpp"
 #include "Engine/Macros/Profiling.hpp"
+#include "Engine/Threading/JobSystem.hpp"
 #include "Engine2D/Behaviour.hpp"
 #include "Engine2D/Entity2D.hpp"
+#include "Engine2D/Physics/AABBTree.hpp"
 #include "Engine2D/Physics/CollisionGrid.hpp"
 #include "Engine2D/Physics/CollisionManifold.hpp"
 #include "Engine2D/Physics/Collisions.hpp"
 #include "Engine2D/Physics/Rigidbody2D.hpp"
+#include "Engine2D/SceneManagement/Scene.hpp"
 #include "Engine2D/Types/Vector2.hpp"
 
 namespace Engine2D::Physics {
   Physics2D::Physics2D()
-    : initialized(false), collisionGridNeedsResizing(false) {}
+    : scene(nullptr), initialized(false), stepCount(0), interpolation(1.0f), collisionGridNeedsResizing(false) {}
 
   Physics2D::~Physics2D() {
     colliders.clear();
@@ -37,13 +40,27 @@ namespace Engine2D::Physics {
   void Physics2D::addCollider(Collider2D *collider) {
     if (!collider)
       return;
+    collider->physicsIndex = colliders.size();
     colliders.emplace_back(collider);
   }
 
   void Physics2D::removeCollider(Collider2D *collider) {
     if (!collider)
       return;
-    std::erase(colliders, collider);
+
+    // Swap the collider with the last one so that removing it does not shift the whole list
+    const size_t index = collider->physicsIndex;
+    if (index >= colliders.size() || colliders[index] != collider)
+      return;
+    if (collider->treeProxy != -1) {
+      aabbTree.destroyLeaf(collider->treeProxy);
+      collider->treeProxy = -1;
+    }
+    if (index != colliders.size() - 1) {
+      colliders[index] = colliders.back();
+      colliders[index]->physicsIndex = index;
+    }
+    colliders.pop_back();
   }
 
   void Physics2D::step() {
@@ -53,39 +70,104 @@ namespace Engine2D::Physics {
       collisionGrid = CollisionGrid{Engine::Settings::Physics::PartitionSize()};
       initialized = true;
     }
+    ++stepCount;
+
+    // Colliders are only kept in the tree while it is used
+    const auto method = Engine::Settings::Physics::BroadPhaseMethod();
+    if (method != Engine::Settings::Physics::BroadPhase::Tree && !aabbTree.empty())
+      clearTree();
 
     // Skip the collision detection if there are no active colliders
     findActiveColliders();
     if (!activeColliders.empty()) {
-      for (const auto &collider: activeColliders)
-        if (const auto &rb = collider->rigidbody; rb && rb->IsActive())
-          rb->step();
-
-      if (Engine::Settings::Physics::UseScreenPartitioning()) {
+      integrateBodies();
+      // The moved bodies and their children are placed once before their bounds are computed
+      if (scene)
+        scene->propagateTransforms(stepCount);
+      computeAABBs();
+      // The broad phase checks the ancestry of the overlapping colliders against the flattened hierarchies
+      if (scene)
+        scene->buildTransformNodes();
+
+      if (method == Engine::Settings::Physics::BroadPhase::Grid) {
         // Update the collision grid
         if (collisionGridNeedsResizing)
           collisionGrid.setGridSize(Engine::Settings::Physics::PartitionSize());
-        collisionGrid.update(activeColliders);
+        collisionGrid.update(activeAABBs);
         // Perform the broad phase for each cell of the grid
         for (auto &gridCol: collisionGrid.grid)
           for (auto &gridCell: gridCol)
             if (!gridCell.empty())
               broadPhase(gridCell);
-      } else
-        broadPhase(activeColliders);
+      } else if (method == Engine::Settings::Physics::BroadPhase::Tree) {
+        updateTree();
+        treeBroadPhase();
+      } else {
+        std::vector<uint32_t> indices(activeColliders.size());
+        std::iota(indices.begin(), indices.end(), 0u);
+        broadPhase(indices);
+      }
       narrowPhase();
 
       // Delete old data
       activeColliders.clear();
+      activeAABBs.clear();
+      activeBodies.clear();
+      dynamicBodies.clear();
       contactPairs.clear();
     }
   }
 
   void Physics2D::findActiveColliders() {
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSubSystem);
-    for (const auto &collider: colliders)
-      if (collider->IsActive())
-        activeColliders.push_back(collider);
+
+    for (const auto &collider: colliders) {
+      if (!collider->IsActive()) {
+        if (collider->treeProxy != -1) {
+          aabbTree.destroyLeaf(collider->treeProxy);
+          collider->treeProxy = -1;
+        }
+        continue;
+      }
+
+      if (!collider->rigidbody)
+        collider->rigidbody = collider->Entity()->GetComponent<Rigidbody2D>();
+      Rigidbody2D *rb = collider->rigidbody.get();
+      activeColliders.push_back(collider);
+      activeBodies.push_back(rb);
+
+      // A rigidbody shared by multiple colliders must only be integrated once per step
+      if (rb && rb->IsActive() && !rb->isKinematic && rb->lastStep != stepCount) {
+        rb->lastStep = stepCount;
+        dynamicBodies.push_back(rb);
+      }
+    }
+  }
+
+  void Physics2D::integrateBodies() const {
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSubSystem);
+
+    for (const auto rb: dynamicBodies) {
+      // Keep the state before the step so that rendering can interpolate up to the result of this step
+      const auto transform = rb->Transform();
+      transform->previousWorldPosition = transform->WorldPosition();
+      transform->previousWorldRotation = transform->WorldRotation();
+      transform->previousPhysicsStep = stepCount;
+      rb->step();
+    }
+  }
+
+  void Physics2D::computeAABBs() {
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSubSystem);
+
+    // Each collider only updates its own bounds, the grid and the broad phase then read them from the dense array
+    activeAABBs.resize(activeColliders.size());
+    Engine::Threading::JobSystem::ParallelFor(
+      activeColliders.size(), 128, [this](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i)
+          activeAABBs[i] = activeColliders[i]->getAABB();
+      }
+    );
   }
 
   void Physics2D::notifyCollisions(
@@ -94,61 +176,70 @@ namespace Engine2D::Physics {
   ) {
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerFunction);
 
-    if (sender->isTrigger) {
-      switch (eventType) {
-        case Stay:
-          for (const auto &behaviour: sender->Entity()->behaviours)
-            behaviour->OnTriggerStay2D(receiver);
+    const auto entity = sender->Entity();
+    uint8_t hook = 0;
+    switch (eventType) {
+      case Stay:
+        hook = sender->isTrigger ? Behaviour::TriggerStayHook : Behaviour::CollisionStayHook;
+        break;
+      case Enter:
+        hook = sender->isTrigger ? Behaviour::TriggerEnterHook : Behaviour::CollisionEnterHook;
+        break;
+      case Exit:
+        hook = sender->isTrigger ? Behaviour::TriggerExitHook : Behaviour::CollisionExitHook;
+        break;
+    }
+
+    // Skip the entity entirely if none of its behaviours listens to this event
+    if (!(entity->behaviourHooks & hook))
+      return;
+
+    for (const auto &behaviour: entity->behaviours) {
+      if (!(behaviour->hooks & hook))
+        continue;
+
+      switch (hook) {
+        case Behaviour::TriggerStayHook:
+          behaviour->OnTriggerStay2D(receiver);
           break;
-        case Enter:
-          for (const auto &behaviour: sender->Entity()->behaviours)
-            behaviour->OnTriggerEnter2D(receiver);
+        case Behaviour::TriggerEnterHook:
+          behaviour->OnTriggerEnter2D(receiver);
           break;
-        case Exit:
-          for (const auto &behaviour: sender->Entity()->behaviours)
-            behaviour->OnTriggerExit2D(receiver);
+        case Behaviour::TriggerExitHook:
+          behaviour->OnTriggerExit2D(receiver);
           break;
-      }
-    } else {
-      switch (eventType) {
-        case Stay:
-          for (const auto &behaviour: sender->Entity()->behaviours)
-            behaviour->OnCollisionStay2D(receiver);
+        case Behaviour::CollisionStayHook:
+          behaviour->OnCollisionStay2D(receiver);
           break;
-        case Enter:
-          for (const auto &behaviour: sender->Entity()->behaviours)
-            behaviour->OnCollisionEnter2D(receiver);
+        case Behaviour::CollisionEnterHook:
+          behaviour->OnCollisionEnter2D(receiver);
           break;
-        case Exit:
-          for (const auto &behaviour: sender->Entity()->behaviours)
-            behaviour->OnCollisionExit2D(receiver);
+        default:
+          behaviour->OnCollisionExit2D(receiver);
           break;
       }
     }
   }
 
-  void Physics2D::broadPhase(const std::vector<Engine::Ptr<Collider2D>> &collidersToChecks) {
+  void Physics2D::broadPhase(const std::vector<uint32_t> &indices) {
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSystem);
 
-    // Precompute AABBs
-    std::vector<std::pair<Engine::Ptr<Collider2D>, Collider2D::AABB>> colliderPairs;
-    colliderPairs.reserve(collidersToChecks.size());
-    for (const auto &col: collidersToChecks)
-      colliderPairs.push_back({col, col->getAABB()});
-
     // Sweep and Prune: Sort colliders by AABB min.x
+    std::vector<uint32_t> sorted = indices;
     std::ranges::sort(
-      colliderPairs, [](const auto &a, const auto &b) {
-        return a.second.min.x < b.second.min.x;
+      sorted, [this](const uint32_t a, const uint32_t b) {
+        return activeAABBs[a].min.x < activeAABBs[b].min.x;
       }
     );
 
     // Collision check loop
-    for (size_t i = 0; i < colliderPairs.size(); ++i) {
-      const auto &[col1, col1AABB] = colliderPairs[i];
+    for (size_t i = 0; i < sorted.size(); ++i) {
+      const uint32_t index1 = sorted[i];
+      const auto &col1AABB = activeAABBs[index1];
 
-      for (size_t j = i + 1; j < colliderPairs.size(); ++j) {
-        const auto &[col2, col2AABB] = colliderPairs[j];
+      for (size_t j = i + 1; j < sorted.size(); ++j) {
+        const uint32_t index2 = sorted[j];
+        const auto &col2AABB = activeAABBs[index2];
 
         // Stop if no overlap on X-axis
         if (col2AABB.min.x > col1AABB.max.x)
@@ -158,36 +249,85 @@ namespace Engine2D::Physics {
         if (col2AABB.min.y > col1AABB.max.y || col1AABB.min.y > col2AABB.max.y)
           continue;
 
-        // Skip self-collisions
-        if (col1->Entity() == col2->Entity())
-          continue;
+        addContactPair(index1, index2);
+      }
+    }
+  }
 
-        // Parent-child relationship check, making sure that both have a rigidbody
-        const auto &rb1 = col1->rigidbody;
-        const auto &rb2 = col2->rigidbody;
-        const bool col1ChildCol2 = col1->Entity()->Transform()->IsChildOf(col2->Entity()) && !(rb1 && rb2);
-        const bool col2ChildCol1 = col2->Entity()->Transform()->IsChildOf(col1->Entity()) && !(rb1 && rb2);
-        if ((!rb1 && !rb2) || col1ChildCol2 || col2ChildCol1)
-          continue;
+  void Physics2D::updateTree() {
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSubSystem);
 
-        // Canonical ordering for each contact pair
-        ContactPair contactPair{
-          col1 < col2 ? col1 : col2,
-          col1 < col2 ? col2 : col1,
-          col1 < col2 ? rb1 : rb2,
-          col1 < col2 ? rb2 : rb1
-        };
+    for (uint32_t i = 0; i < activeColliders.size(); ++i) {
+      auto &proxy = activeColliders[i]->treeProxy;
+      if (proxy == -1)
+        proxy = aabbTree.createLeaf(activeAABBs[i], i);
+      else
+        aabbTree.moveLeaf(proxy, activeAABBs[i], i);
+    }
+  }
 
-        // Handle previous collision exit notifications
-        if (previousCollisionPairs.contains(contactPair)) {
-          notifyCollisions(col1, col2, Exit);
-          notifyCollisions(col2, col1, Exit);
+  void Physics2D::treeBroadPhase() {
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSystem);
+
+    for (uint32_t i = 0; i < activeColliders.size(); ++i) {
+      const auto &aabb = activeAABBs[i];
+      aabbTree.query(
+        aabb, [&](const uint32_t other) {
+          // Each pair is found from both of its colliders, and the leaves are enlarged so the real bounds are checked
+          if (other <= i)
+            return;
+          const auto &otherAABB = activeAABBs[other];
+          if (otherAABB.min.x > aabb.max.x || aabb.min.x > otherAABB.max.x)
+            return;
+          if (otherAABB.min.y > aabb.max.y || aabb.min.y > otherAABB.max.y)
+            return;
+          addContactPair(i, other);
         }
+      );
+    }
+  }
 
-        // Store contact pair
-        contactPairs.push_back(contactPair);
-      }
+  void Physics2D::clearTree() {
+    for (const auto &collider: colliders)
+      collider->treeProxy = -1;
+    aabbTree.clear();
+  }
+
+  void Physics2D::addContactPair(const uint32_t index1, const uint32_t index2) {
+    const auto &col1 = activeColliders[index1];
+    const auto &col2 = activeColliders[index2];
+
+    // Skip self-collisions
+    if (col1->Entity() == col2->Entity())
+      return;
+
+    // Colliders without a rigidbody never collide, and parents and children only collide if both have one
+    const Engine::Ptr<Rigidbody2D> rb1 = activeBodies[index1];
+    const Engine::Ptr<Rigidbody2D> rb2 = activeBodies[index2];
+    if (!rb1 && !rb2)
+      return;
+    if (
+      !(rb1 && rb2) && (col1->Entity()->Transform()->IsChildOf(col2->Entity()) ||
+        col2->Entity()->Transform()->IsChildOf(col1->Entity()))
+    )
+      return;
+
+    // Canonical ordering for each contact pair
+    ContactPair contactPair{
+      col1 < col2 ? col1 : col2,
+      col1 < col2 ? col2 : col1,
+      col1 < col2 ? rb1 : rb2,
+      col1 < col2 ? rb2 : rb1
+    };
+
+    // Handle previous collision exit notifications
+    if (previousCollisionPairs.contains(contactPair)) {
+      notifyCollisions(col1, col2, Exit);
+      notifyCollisions(col2, col1, Exit);
     }
+
+    // Store contact pair
+    contactPairs.push_back(contactPair);
   }
 
   void Physics2D::narrowPhase() {
@@ -15,7 +15,7 @@ namespace Engine2D::Physics {
   Rigidbody2D::Rigidbody2D()
     : isKinematic(false), affectedByGravity(true), linearVelocity(glm::vec2(0)), angularVelocity(0), angularDamping(1),
       staticFriction(0.6f), dynamicFriction(0.4f), mass(1), massInv(1), inertia(0), inertiaInv(0),
-      force(glm::vec2(0)) {}
+      force(glm::vec2(0)), lastStep(0) {}
 
   void Rigidbody2D::SetMass(const float mass) {
     if (this->mass <= 0) {
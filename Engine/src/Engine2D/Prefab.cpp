@@ -0,0 +1,186 @@
+//
+// Prefab.cpp
+// Author: Antoine Bastide
+// Date: 16.10.2026
+//
+
+#include <algorithm>
+
+#include "Engine2D/Prefab.hpp"
+#include "Engine/Macros/Profiling.hpp"
+#include "Engine/Reflection/ReflectionFactory.hpp"
+#include "Engine2D/Behaviour.hpp"
+#include "Engine2D/Entity2D.hpp"
+#include "Engine2D/SceneManagement/Scene.hpp"
+#include "Engine2D/SceneManagement/SceneManager.hpp"
+
+namespace Engine2D {
+  Prefab::Prefab(const Engine::Ptr<Entity2D> &entity) {
+    if (entity)
+      capture(entity.get(), -1);
+  }
+
+  Prefab::~Prefab() = default;
+
+  Prefab::Prefab(Prefab &&) noexcept = default;
+
+  Prefab &Prefab::operator=(Prefab &&) noexcept = default;
+
+  Engine::Ptr<Entity2D> Prefab::Instantiate(
+    const glm::vec2 position, const float rotation, const Engine::Ptr<Entity2D> &parent
+  ) const {
+    const auto instances = Instantiate(std::vector{position}, rotation, parent);
+    return instances.empty() ? Engine::Ptr<Entity2D>() : instances.front();
+  }
+
+  std::vector<Engine::Ptr<Entity2D>> Prefab::Instantiate(
+    const std::vector<glm::vec2> &positions, const float rotation, const Engine::Ptr<Entity2D> &parent
+  ) const {
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerFunction);
+
+    std::vector<Engine::Ptr<Entity2D>> roots;
+    const auto scene = SceneManager::ActiveScene();
+    if (nodes.empty() || !scene || positions.empty())
+      return roots;
+
+    reserve(scene.get(), positions.size());
+    roots.reserve(positions.size());
+    std::vector<Component2D *> toForward;
+    size_t forwardedPerInstance = 0;
+    for (const auto &node: nodes)
+      forwardedPerInstance += node.components.size() - node.behaviourCount;
+    toForward.reserve(forwardedPerInstance * positions.size());
+
+    for (const auto position: positions)
+      roots.emplace_back(instantiate(scene.get(), position, rotation, parent, toForward));
+
+    // Every copy exists now, so their components are handed to the physics, rendering and animation systems together
+    for (const auto component: toForward)
+      component->forward();
+
+    return roots;
+  }
+
+  const std::string &Prefab::Name() const {
+    static const std::string empty;
+    return nodes.empty() ? empty : nodes.front().name;
+  }
+
+  size_t Prefab::EntityCount() const {
+    return nodes.size();
+  }
+
+  void Prefab::capture(const Entity2D *entity, const int parent) {
+    const auto index = static_cast<int>(nodes.size());
+    Node &node = nodes.emplace_back();
+    node.name = entity->name;
+    node.active = entity->active;
+    node.isStatic = entity->isStatic;
+    node.position = entity->transform->Position();
+    node.rotation = entity->transform->Rotation();
+    node.scale = entity->transform->Scale();
+    node.parent = parent;
+    node.behaviourCount = 0;
+    node.maxTypeId = 0;
+
+    node.components.reserve(entity->allComponents.size());
+    for (const auto &source: entity->allComponents) {
+      Component &component = node.components.emplace_back();
+      component.typeId = source->typeId;
+      component.behaviour = dynamic_cast<const Behaviour *>(source.get()) != nullptr;
+      component.copy = Engine::Reflection::ReflectionFactory::Clone<Component2D>(*source);
+
+      // Types without a copy constructor are serialized once here instead of for every instance
+      if (!component.copy) {
+        component.type = source->ClassNameQualified();
+        source->_e_save(Engine::Reflection::Format::JSON, component.json);
+        source->OnSerialize(Engine::Reflection::Format::JSON, component.json);
+      }
+
+      node.behaviourCount += component.behaviour;
+      node.maxTypeId = std::max(node.maxTypeId, component.typeId);
+      if (component.typeId >= componentsPerType.size())
+        componentsPerType.resize(component.typeId + 1, 0);
+      ++componentsPerType[component.typeId];
+    }
+
+    // The node can be moved by the captures of the children, so it is not used past this point
+    for (const auto &child: entity->transform->children)
+      if (child && !child->destroyed)
+        capture(child.get(), index);
+  }
+
+  Entity2D *Prefab::instantiate(
+    Scene *scene, const glm::vec2 position, const float rotation, const Engine::Ptr<Entity2D> &parent,
+    std::vector<Component2D *> &toForward
+  ) const {
+    std::vector<Entity2D *> entities;
+    entities.reserve(nodes.size());
+
+    for (const auto &node: nodes) {
+      const bool root = node.parent < 0;
+      const auto entity = new Entity2D(
+        node.name, node.isStatic, root ? position : node.position, root ? rotation : node.rotation, node.scale,
+        root ? parent : Engine::Ptr<Entity2D>(entities[node.parent])
+      );
+      entity->id = Entity2D::nextId++;
+      entity->scene = scene;
+      entity->active = node.active;
+
+      // Size the storage of the entity once instead of growing it with each component
+      entity->allComponents.reserve(node.components.size());
+      entity->components.reserve(node.components.size() - node.behaviourCount);
+      entity->behaviours.reserve(node.behaviourCount);
+      entity->behavioursToInitialize.reserve(node.behaviourCount);
+      if (!node.components.empty())
+        entity->componentSlots.resize(node.maxTypeId + 1, nullptr);
+
+      for (const auto &component: node.components) {
+        auto copy = clone(component);
+        copy->entity = entity;
+        Component2D *ptr = copy.get();
+        entity->allComponents.emplace_back(std::move(copy));
+        entity->registerComponent(ptr, component.typeId);
+        if (component.behaviour) {
+          const auto behaviour = static_cast<Behaviour *>(ptr);
+          entity->queueInitialization(behaviour);
+          entity->addBehaviour(behaviour);
+        } else {
+          entity->components.emplace_back(ptr);
+          toForward.emplace_back(ptr);
+        }
+      }
+
+      // Components restored from their serialized representation finish loading once they are attached
+      for (size_t i = 0; i < node.components.size(); ++i)
+        if (!node.components[i].copy)
+          entity->allComponents[i]->OnDeserialize(Engine::Reflection::Format::JSON, node.components[i].json);
+
+      scene->indexName(entity);
+      scene->entitiesToAdd.emplace_back(entity);
+      entities.emplace_back(entity);
+    }
+
+    return entities.front();
+  }
+
+  void Prefab::reserve(Scene *scene, const size_t count) const {
+    scene->entitiesToAdd.reserve(scene->entitiesToAdd.size() + nodes.size() * count);
+    if (componentsPerType.size() > scene->componentsByType.size())
+      scene->componentsByType.resize(componentsPerType.size());
+    for (size_t typeId = 0; typeId < componentsPerType.size(); ++typeId)
+      if (componentsPerType[typeId] > 0) {
+        auto &components = scene->componentsByType[typeId];
+        components.reserve(components.size() + componentsPerType[typeId] * count);
+      }
+  }
+
+  std::unique_ptr<Component2D> Prefab::clone(const Component &component) {
+    if (component.copy)
+      return Engine::Reflection::ReflectionFactory::Clone<Component2D>(*component.copy);
+
+    auto copy = Engine::Reflection::ReflectionFactory::CreateUnique<Component2D>(component.type);
+    copy->_e_load(Engine::Reflection::Format::JSON, component.json);
+    return copy;
+  }
+}
@@ -13,6 +13,7 @@
 #include "Engine2D/Game2D.hpp"
 #include "Engine2D/Transform2D.hpp"
 #include "Engine2D/SceneManagement/SceneManager.hpp"
+#include "Engine2D/Types/Affine2D.hpp"
 #include "Engine2D/Types/Vector2.hpp"
 
 namespace Engine2D::Rendering {
@@ -21,20 +22,13 @@ namespace Engine2D::Rendering {
 
   Camera2D::Camera2D(const float left, const float right, const float bottom, const float top)
     : positionOffset(0), rotationOffset(0), damping(1), zoomLevel(1.0f),
-      projection(glm::ortho(left, right, bottom, top, near, far)), view(1.0f), initialized(false), shaking(false),
-      shakeDuration(0), shakeElapsed(0), ubo(0), followTargetIndex(-1), velocity(),
+      projection(glm::ortho(left, right, bottom, top, near, far)), view(1.0f), shaking(false),
+      shakeDuration(0), shakeElapsed(0), followTargetIndex(-1), velocity(),
       rotationMatrix(), worldRotationLastFrame(std::numeric_limits<float>::quiet_NaN()), invZoom(1), left(left),
       right(right), bottom(bottom), top(top) {
     viewProjection = projection * view;
   }
 
-  Camera2D::~Camera2D() {
-    if (ubo > 0) {
-      glDeleteBuffers(1, &ubo);
-      ubo = 0;
-    }
-  }
-
   void Camera2D::Shake(const float duration) {
     shaking = true;
     shakeElapsed = 0;
@@ -121,25 +115,9 @@ namespace Engine2D::Rendering {
     SetProjection(left, right, bottom, top);
   }
 
-  void Camera2D::initialize() {
-    // Bind the engine data ubo
-    glGenBuffers(1, &ubo);
-    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
-    glBufferData(GL_UNIFORM_BUFFER, 3 * sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
-    // Set the binding port
-    glBindBufferBase(GL_UNIFORM_BUFFER, ENGINE_DATA_BINDING_PORT, ubo);
-
-    initialized = true;
-  }
-
   void Camera2D::updateCamera() {
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSubSystem);
 
-    if (!initialized)
-      initialize();
-
     /// Update the camera's transform
     if (followTarget) {
       const glm::vec2 target = followTarget->Transform()->WorldPosition() + positionOffset;
@@ -155,10 +133,10 @@ namespace Engine2D::Rendering {
     }
 
     // Compute the view so that we can apply the camera shake to it
-    // First negate the world rotation because of matrix inversion
-    Transform()->worldRotation = -Transform()->worldRotation;
-    glm::mat4 baseView = glm::scale(glm::inverse(Transform()->WorldMatrix()), glm::vec3(zoomLevel, zoomLevel, 1.0f));
-    Transform()->worldRotation = -Transform()->worldRotation;
+    // The world rotation is negated because of the matrix inversion
+    const auto transform = Transform();
+    Affine2D baseView = Affine2D::TRS(transform->WorldPosition(), -transform->WorldRotation(), transform->WorldScale())
+                        .Inverse() * Affine2D::Scale(glm::vec2(zoomLevel));
 
     // Rotate into camera space
     if (const auto cameraRotation = Transform()->WorldRotation(); cameraRotation != worldRotationLastFrame) {
@@ -177,25 +155,14 @@ namespace Engine2D::Rendering {
     if (shaking) {
       shakeElapsed += Game2D::DeltaTime();
       if (const float dt = shakeElapsed / shakeDuration; dt < 1.0f)
-        baseView = glm::translate(glm::mat4(1.0f), glm::vec3(getCameraShake(dt), 0.0f)) * baseView;
+        baseView = Affine2D::Translation(getCameraShake(dt)) * baseView;
       else
         shaking = false;
     }
 
     // Update the camera's matrices
-    view = baseView;
+    view = baseView.ToMat4();
     viewProjection = projection * view;
-
-    // Send the engine data to shaders
-    void *ptr = glMapBufferRange(
-      GL_UNIFORM_BUFFER, 0, 3 * sizeof(glm::mat4), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT
-    );
-    if (ptr) {
-      memcpy(ptr, &view, sizeof(glm::mat4));
-      memcpy(static_cast<char *>(ptr) + sizeof(glm::mat4), &projection, sizeof(glm::mat4));
-      memcpy(static_cast<char *>(ptr) + 2 * sizeof(glm::mat4), &viewProjection, sizeof(glm::mat4));
-      glUnmapBuffer(GL_UNIFORM_BUFFER);
-    }
   }
 
   glm::vec2 Camera2D::getCameraShake(const float frac) const {
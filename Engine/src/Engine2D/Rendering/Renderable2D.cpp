@@ -14,7 +14,11 @@ namespace Engine2D::Rendering {
 
   Renderable2D::Renderable2D(const RenderableType type)
     : renderOrder(0), renderType(type), shader(Engine::ResourceManager::GetShader("sprite")), sprite(nullptr),
-      dirty(true) {}
+      dirty(true), transformVersion(0), resourceIndex(0), staticGroup(0) {}
+
+  Renderable2D::Renderable2D(const Renderable2D &other)
+    : Component2D(other), renderOrder(other.renderOrder), renderType(other.renderType), shader(other.shader),
+      sprite(other.sprite), dirty(true), transformVersion(0), resourceIndex(0), staticGroup(0) {}
 
   void Renderable2D::SetShader(Engine::Rendering::Shader *shader) {
     this->shader = shader;
@@ -4,15 +4,19 @@
 // Date: 10/11/2024
 //
 
+#include <cstring>
 #include <numeric>
+#include <ranges>
 #include <vector>
 
 #include "Engine2D/Rendering/Renderer2D.hpp"
 #include "Engine/ResourceManager.hpp"
 #include "Engine/Macros/Assert.hpp"
 #include "Engine/Macros/Profiling.hpp"
+#include "Engine/Threading/JobSystem.hpp"
 #include "Engine2D/Entity2D.hpp"
 #include "Engine/Rendering/Shader.hpp"
+#include "Engine2D/Rendering/Camera2D.hpp"
 #include "Engine2D/Rendering/Sprite.hpp"
 #include "Engine2D/Rendering/SpriteRenderer.hpp"
 #include "Engine/Rendering/Texture.hpp"
@@ -25,29 +29,21 @@
 #define MAX_BATCH_SIZE (1024 * 1024)
 #define MAX_BATCH_SIZE_WITH_STRIDE (MAX_BATCH_SIZE / STRIDE_SIZE)
 #define MAX_INSTANCE_COUNT 10000
+#define EXTRACTION_GRAIN_SIZE 256
 
 namespace Engine2D::Rendering {
   Renderer2D::~Renderer2D() {
-    if (quadVAO > 0) {
-      glDeleteVertexArrays(1, &quadVAO);
-      quadVAO = 0;
-    }
-    if (vertexVBO > 0) {
-      glDeleteBuffers(1, &vertexVBO);
-      vertexVBO = 0;
-    }
-    if (batchVBO > 0) {
-      glDeleteBuffers(1, &batchVBO);
-      batchVBO = 0;
-    }
-    if (staticOpaqueBatchVBO > 0) {
-      glDeleteBuffers(1, &staticOpaqueBatchVBO);
-      staticOpaqueBatchVBO = 0;
-    }
-    if (staticTransparentBatchVBO > 0) {
-      glDeleteBuffers(1, &staticTransparentBatchVBO);
-      staticTransparentBatchVBO = 0;
-    }
+    // The renderer can be destroyed from the update thread, the buffers are freed by the thread that owns the context
+    const std::array buffers{vertexVBO, batchVBO, staticOpaqueBatchVBO, staticTransparentBatchVBO, cameraUBO};
+    Game2D::RunOnRenderThread(
+      [vertexArray = quadVAO, buffers] {
+        if (vertexArray > 0)
+          glDeleteVertexArrays(1, &vertexArray);
+        for (const uint buffer: buffers)
+          if (buffer > 0)
+            glDeleteBuffers(1, &buffer);
+      }
+    );
   }
 
   float Renderer2D::PackTwoFloats(const float a, const float b) {
@@ -64,7 +60,7 @@ namespace Engine2D::Rendering {
 
   bool Renderer2D::cannotBeRendered(const Renderable2D *r) {
     return !r->Entity()->IsActive() || !r->IsActive() || !r->Transform()->IsVisible() || !r->shader ||
-           !r->sprite || !r->sprite->texture;
+           !r->shader->id || !r->sprite || !r->sprite->texture || !r->sprite->texture->id;
   }
 
   bool Renderer2D::sortRenderers(const Renderable2D *a, const Renderable2D *b) const {
@@ -78,7 +74,10 @@ namespace Engine2D::Rendering {
     return a->sprite->texture->id < b->sprite->texture->id;
   }
 
-  void Renderer2D::extractRendererData(const SpriteRenderer *renderer, float *data) const {
+  void Renderer2D::extractRendererData(
+    const SpriteRenderer *renderer, float *data, const uint textureIndex, const float interpolation,
+    const uint64_t physicsStep
+  ) {
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerFunction);
 
     if (cannotBeRendered(renderer))
@@ -92,8 +91,9 @@ namespace Engine2D::Rendering {
     const auto rect = sprite->rect;
 
     // Position and scale
-    *data++ = r.Transform()->WorldPosition().x;
-    *data++ = r.Transform()->WorldPosition().y;
+    const glm::vec2 position = r.Transform()->interpolatedWorldPosition(interpolation, physicsStep);
+    *data++ = position.x;
+    *data++ = position.y;
     *data++ = r.Transform()->WorldScale().x * invPPU;
     *data++ = r.Transform()->WorldScale().y * invPPU;
 
@@ -114,118 +114,182 @@ namespace Engine2D::Rendering {
       std::clamp(r.sprite->pivot.x, -1.0f, 1.0f),
       std::clamp(r.sprite->pivot.y, -1.0f, 1.0f)
     );
-    *data++ = r.Transform()->WorldRotation();
-    *data++ = r.renderOrder << 16 | textureIdToIndexMap.at(r.sprite->texture->id);
+    *data++ = r.Transform()->interpolatedWorldRotation(interpolation, physicsStep);
+    *data++ = r.renderOrder << 16 | textureIndex;
     *data = PackTwoFloats(r.Flip().x ? -1.0f : 1.0, r.Flip().y ? -1.0f : 1.0);
   }
 
-  void Renderer2D::mapTextureIdToIndex(const uint &textureId) {
+  uint Renderer2D::mapTextureIdToIndex(const uint textureId) {
     // Do nothing for invalid texture id's
-    if (textureId == 0) {
-      return;
-    }
+    if (textureId == 0)
+      return 0;
 
     // Do nothing if the id is already mapped
-    if (textureIdToIndexMap.contains(textureId)) {
-      Engine::ResourceManager::GetTexture2DById(textureId)->bind(textureIdToIndexMap.at(textureId));
-      return;
-    }
+    if (const auto it = textureIdToIndexMap.find(textureId); it != textureIdToIndexMap.end())
+      return it->second;
 
     // Reset the mapping
     if (textureIdToIndexMap.size() >= MAX_TEXTURES)
       textureIdToIndexMap.clear();
 
-    // Create the mapping
-    const int texIndex = static_cast<int>(textureIdToIndexMap.size());
+    // Create the mapping, the texture is bound to its index when its flush is drawn
+    const uint texIndex = static_cast<uint>(textureIdToIndexMap.size());
     textureIdToIndexMap.emplace(textureId, texIndex);
-    Engine::ResourceManager::GetTexture2DById(textureId)->bind(texIndex);
+    return texIndex;
   }
 
-  void Renderer2D::buildAndRenderStaticBatch(
-    std::vector<SpriteRenderer *> &renderers, std::vector<float> &batchData,
-    std::vector<Flush> &flushList, const bool rebuild, const uint VBO, const uint framebuffer
+  void Renderer2D::buildStaticBatch(
+    std::vector<SpriteRenderer *> &renderers, FrameSnapshot::Batch &batch, const bool rebuild
   ) {
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSystem);
 
-    if (rebuild) {
-      std::ranges::sort(
-        renderers, [this](const Renderable2D *a, const Renderable2D *b) {
-          return sortRenderers(a, b);
-        }
-      );
+    if (!rebuild) {
+      if (updateBatch(renderers, batch.data))
+        batch.version++;
+      return;
+    }
 
-      // Only extract data for valid sprite renderers
-      uint32_t start = 0, count = 0, currentShaderID = 0, currentTextureID = 0, index = 0;
-
-      flushList.clear();
-      batchData.clear();
-      batchData.reserve(renderers.size() * STRIDE);
-      batchData.resize(renderers.size() * STRIDE);
-
-      for (const auto &renderer: renderers) {
-        // Check for change in shader or texture ID
-        const uint32_t shaderID = renderer->shader->id;
-        if (const uint32_t textureID = renderer->sprite->texture->id;
-          shaderID != currentShaderID || textureID != currentTextureID) {
-          // Save the previous flush range if any
-          if (count > 0) {
-            flushList.emplace_back(currentShaderID, currentTextureID, start, count, 10000);
-            start += count;
-            count = 0;
-          }
+    std::ranges::sort(
+      renderers, [this](const Renderable2D *a, const Renderable2D *b) {
+        return sortRenderers(a, b);
+      }
+    );
 
-          currentShaderID = shaderID;
-          currentTextureID = textureID;
-          mapTextureIdToIndex(textureID);
+    // Only extract data for valid sprite renderers
+    uint32_t start = 0, count = 0, currentShaderID = 0, currentTextureID = 0, currentTextureIndex = 0, index = 0;
+
+    auto &[batchData, flushList, version] = batch;
+    flushList.clear();
+    batchData.clear();
+    batchData.reserve(renderers.size() * STRIDE);
+    batchData.resize(renderers.size() * STRIDE);
+
+    batchEntries.clear();
+    for (const auto &renderer: renderers) {
+      // Check for change in shader or texture ID
+      const uint32_t shaderID = renderer->shader->id;
+      if (const uint32_t textureID = renderer->sprite->texture->id;
+        shaderID != currentShaderID || textureID != currentTextureID) {
+        // Save the previous flush range if any, static sprites are always alpha blended
+        if (count > 0) {
+          flushList.emplace_back(currentShaderID, currentTextureID, start, count, 0, currentTextureIndex);
+          start += count;
+          count = 0;
         }
 
-        extractRendererData(renderer, &batchData[index * STRIDE]);
-        count++;
-        index++;
+        currentShaderID = shaderID;
+        currentTextureID = textureID;
+        currentTextureIndex = mapTextureIdToIndex(textureID);
       }
-      if (count > 0)
-        flushList.emplace_back(currentShaderID, currentTextureID, start, count, 10000);
-    } else
-      updateBatch(renderers, batchData);
 
-    for (auto &[shaderID, textureID, start, count, blendMode]: flushList) {
-      if (shaderID == 0 || textureID == 0)
-        continue;
+      batchEntries.emplace_back(renderer, index, currentTextureIndex);
+      count++;
+      index++;
+    }
+    if (count > 0)
+      flushList.emplace_back(currentShaderID, currentTextureID, start, count, 0, currentTextureIndex);
+    extractBatchData(batchData.data());
+    version++;
+  }
 
-      if (shaderID != lastShaderID) {
-        lastShaderID = shaderID;
-        Engine::ResourceManager::GetShaderById(shaderID)->use();
+  void Renderer2D::buildStaticGroups(std::map<uint32_t, StaticGroup> &groups, FrameSnapshot::Batch &batch) {
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSystem);
+
+    bool updated = false;
+    for (auto it = groups.begin(); it != groups.end();) {
+      auto &[renderers, groupBatch, changed] = it->second;
+      if (renderers.empty()) {
+        it = groups.erase(it);
+        updated = true;
+        continue;
       }
 
-      mapTextureIdToIndex(textureID);
-      setBlendMode(blendMode >> 5 == 1, false, ParticleSystem2D::Alpha);
-      flush(VBO, &batchData[start * STRIDE], GL_STATIC_DRAW, count, framebuffer);
+      const auto lastVersion = groupBatch.version;
+      buildStaticBatch(renderers, groupBatch, changed);
+      updated |= groupBatch.version != lastVersion;
+      changed = false;
+      ++it;
     }
+
+    if (!updated)
+      return;
+
+    // Join the batches of the groups, the flushes of each group start after the sprites of the groups before it
+    auto &[batchData, flushList, version] = batch;
+    batchData.clear();
+    flushList.clear();
+    for (const auto &[renderers, groupBatch, changed]: groups | std::views::values) {
+      const auto offset = static_cast<uint32_t>(batchData.size() / STRIDE);
+      batchData.insert(batchData.end(), groupBatch.data.begin(), groupBatch.data.end());
+      for (const auto &[shaderID, textureID, start, count, blendMode, textureIndex]: groupBatch.flushList)
+        flushList.emplace_back(shaderID, textureID, offset + start, count, blendMode, textureIndex);
+    }
+    version++;
   }
 
-  void Renderer2D::updateBatch(
+  bool Renderer2D::updateBatch(
     const std::vector<SpriteRenderer *> &renderers, std::vector<float> &staticBatchData
   ) const {
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSubSystem);
 
-    for (size_t i = 0; i < renderers.size(); i++) {
-      auto &renderer = renderers[i];
-      const size_t offset = i * STRIDE;
-      if (cannotBeRendered(renderer)) {
-        auto data = &staticBatchData[offset];
-        data += 2;
-        *data++ = 0.0f;
-        *data = 0.0f;
-      } else if (renderer->dirty) {
-        extractRendererData(renderer, &staticBatchData[offset]);
-        renderer->dirty = false;
+    std::atomic<bool> updated = false;
+    Engine::Threading::JobSystem::ParallelFor(
+      renderers.size(), EXTRACTION_GRAIN_SIZE, [&](const size_t begin, const size_t end) {
+        bool chunkUpdated = false;
+        for (size_t i = begin; i < end; i++) {
+          auto &renderer = renderers[i];
+          const size_t offset = i * STRIDE;
+          if (cannotBeRendered(renderer)) {
+            auto data = &staticBatchData[offset];
+            data += 2;
+            chunkUpdated |= data[0] != 0.0f || data[1] != 0.0f;
+            *data++ = 0.0f;
+            *data = 0.0f;
+          } else if (renderer->dirty || renderer->transformVersion != renderer->Transform()->version) {
+            extractRendererData(
+              renderer, &staticBatchData[offset], textureIdToIndexMap.at(renderer->sprite->texture->id)
+            );
+            renderer->dirty = false;
+            renderer->transformVersion = renderer->Transform()->version;
+            chunkUpdated = true;
+          }
+        }
+        if (chunkUpdated)
+          updated = true;
       }
-    }
+    );
+    return updated;
   }
 
-  void Renderer2D::buildAndRenderBatch(
-    std::vector<Renderable2D *> &renderers, std::vector<Flush> &flushList, const uint particleCount, const bool resort,
-    const uint framebuffer
+  void Renderer2D::extractBatchData(float *data) {
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSubSystem);
+
+    // Render the bodies moved by the physics engine between the last two steps, using the leftover simulation time
+    const bool interpolate = Engine::Settings::Physics::Interpolation();
+    const float interpolation = interpolate ? scene->physicsSystem.interpolation : 1.0f;
+    const uint64_t physicsStep = interpolate ? scene->physicsSystem.stepCount : 0;
+
+    // Each entry writes to its own range of the batch, so they can all be extracted in parallel
+    Engine::Threading::JobSystem::ParallelFor(
+      batchEntries.size(), EXTRACTION_GRAIN_SIZE, [&](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; i++) {
+          const auto &[renderer, offset, textureIndex] = batchEntries[i];
+          if (renderer->renderType == Renderable2D::ParticleSystem) {
+            // The capacity has not changed since the batch reserved the instances of the particle system
+            const auto particleSystem = static_cast<ParticleSystem2D *>(renderer);
+            particleSystem->updateAndRender(textureIndex, &data[offset * STRIDE], particleSystem->capacity);
+          } else
+            extractRendererData(
+              static_cast<SpriteRenderer *>(renderer), &data[offset * STRIDE], textureIndex, interpolation, physicsStep
+            );
+        }
+      }
+    );
+    batchEntries.clear();
+  }
+
+  void Renderer2D::buildBatch(
+    std::vector<Renderable2D *> &renderers, FrameSnapshot::Batch &batch, const uint particleCount, const bool resort
   ) {
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSystem);
 
@@ -236,70 +300,65 @@ namespace Engine2D::Rendering {
         }
       );
 
+    auto &[batchData, flushList, version] = batch;
     flushList.clear();
 
-    uint32_t start = 0, count = 0, currentShaderID = 0, currentTextureID = 0, index = 0;
+    uint32_t start = 0, count = 0, currentShaderID = 0, currentTextureID = 0, currentTextureIndex = 0, index = 0;
 
     // Only extract data for valid sprite renderers
     const auto it = std::ranges::find_if(renderers, cannotBeRendered);
     const auto validRange = std::ranges::subrange(renderers.begin(), it);
+    batchData.resize((validRange.size() + particleCount) * STRIDE);
 
-    // Bind the target frame buffer
-    if (framebuffer > 0)
-      glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
-
-    glBindBuffer(GL_ARRAY_BUFFER, batchVBO);
-    glBufferData(GL_ARRAY_BUFFER, (validRange.size() + particleCount) * STRIDE_SIZE, nullptr, GL_STREAM_DRAW);
-
-    const auto gpuPtr = static_cast<float *>(glMapBufferRange(
-      GL_ARRAY_BUFFER, 0, (validRange.size() + particleCount) * STRIDE_SIZE,
-      GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT
-    ));
-
-    if (!gpuPtr)
-      return;
-
+    batchEntries.clear();
     for (const auto &renderer: validRange) {
       // Send the previous sprites to the flush list
       const uint32_t shaderID = renderer->shader->id;
       const uint32_t textureID = renderer->sprite->texture->id;
       if (currentShaderID != shaderID || currentTextureID != textureID) {
         if (count > 0) {
-          flushList.emplace_back(currentShaderID, currentTextureID, start, count, !zSort << 5 | 0);
+          flushList.emplace_back(
+            currentShaderID, currentTextureID, start, count, !zSort << 5 | 0, currentTextureIndex
+          );
           start += count;
           count = 0;
         }
 
         currentShaderID = shaderID;
         currentTextureID = textureID;
+        currentTextureIndex = mapTextureIdToIndex(textureID);
       }
 
-      mapTextureIdToIndex(textureID);
-
+      batchEntries.emplace_back(renderer, index, currentTextureIndex);
       if (renderer->renderType == Renderable2D::ParticleSystem) {
-        const auto particleSystem = dynamic_cast<ParticleSystem2D *>(renderer);
+        const auto particleSystem = static_cast<ParticleSystem2D *>(renderer);
         const int capacity = particleSystem->capacity;
-        particleSystem->updateAndRender(textureIdToIndexMap.at(textureID), &gpuPtr[index * STRIDE]);
 
         // Send the particles to the flush list
         flushList.emplace_back(
           currentShaderID, currentTextureID, start, capacity,
-          !zSort << 5 | 1 << 4 | static_cast<int>(particleSystem->blendMode)
+          !zSort << 5 | 1 << 4 | static_cast<int>(particleSystem->blendMode), currentTextureIndex
         );
         start += capacity;
         index += capacity;
       } else {
-        extractRendererData(static_cast<SpriteRenderer *>(renderer), &gpuPtr[index * STRIDE]);
         count++;
         index++;
       }
     }
     if (count > 0)
-      flushList.emplace_back(currentShaderID, currentTextureID, start, count, !zSort << 5 | 0);
+      flushList.emplace_back(currentShaderID, currentTextureID, start, count, !zSort << 5 | 0, currentTextureIndex);
 
-    glUnmapBuffer(GL_ARRAY_BUFFER);
+    extractBatchData(batchData.data());
+    version++;
+  }
 
-    for (auto &[shaderID, textureID, start, count, blendMode]: flushList) {
+  void Renderer2D::renderBatch(
+    const FrameSnapshot::Batch &batch, const uint VBO, const int drawMode, const uint framebuffer
+  ) {
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSystem);
+
+    for (auto &[shaderID, textureID, start, count, blendMode, textureIndex]: batch.flushList) {
       if (shaderID == 0 || textureID == 0)
         continue;
 
@@ -308,19 +367,15 @@ namespace Engine2D::Rendering {
         Engine::ResourceManager::GetShaderById(shaderID)->use();
       }
 
-      mapTextureIdToIndex(textureID);
+      Engine::ResourceManager::GetTexture2DById(textureID)->bind(textureIndex);
       const bool isParticle = (blendMode >> 4 & 1) == 1;
       const auto blend = static_cast<ParticleSystem2D::BlendMode>(blendMode & 7);
       setBlendMode(blendMode >> 5 == 1, isParticle, blend);
-      flush(batchVBO, &gpuPtr[start * STRIDE], GL_DYNAMIC_DRAW, count, framebuffer);
+      flush(VBO, &batch.data[start * STRIDE], drawMode, count, framebuffer);
 
       if (isParticle && blend == ParticleSystem2D::Subtractive)
         glBlendEquation(GL_FUNC_ADD);
     }
-
-    // Unbind the target frame buffer
-    if (framebuffer > 0)
-      glBindFramebuffer(GL_FRAMEBUFFER, 0);
   }
 
   void Renderer2D::setBlendMode(const bool opaque, const bool isParticle, const ParticleSystem2D::BlendMode blendMode) {
@@ -473,29 +528,30 @@ namespace Engine2D::Rendering {
     // Cleanup: unbind the VBO and VAO
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
+
+    // --- Set up the camera uniform buffer ---
+    glGenBuffers(1, &cameraUBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, cameraUBO);
+    glBufferData(GL_UNIFORM_BUFFER, 3 * sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, Camera2D::ENGINE_DATA_BINDING_PORT, cameraUBO);
   }
 
   void Renderer2D::updateAndSplitRenderList() {
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSystem);
 
-    if (!quadVAO)
-      initRenderData();
-
     const auto lastOpaqueCount = opaqueRenderers.size();
-    lastOpaqueStaticCount = staticOpaqueRenderers.size();
-    lastTransparentStaticCount = staticTransparentRenderers.size();
 
     if (!renderersToRemove.empty()) {
-      std::erase_if(
-        staticTransparentRenderers, [&](const auto &r) {
-          return renderersToRemove.contains(r);
-        }
-      );
-      std::erase_if(
-        staticOpaqueRenderers, [&](const auto &r) {
-          return renderersToRemove.contains(r);
-        }
-      );
+      // Only the static groups the removed renderers were part of are searched
+      for (auto *groups: {&staticOpaqueGroups, &staticTransparentGroups})
+        for (auto &[renderers, batch, changed]: *groups | std::views::values)
+          if (changed)
+            std::erase_if(
+              renderers, [&](const auto &r) {
+                return renderersToRemove.contains(r);
+              }
+            );
       std::erase_if(
         transparentRenderers, [&](const auto &r) {
           return renderersToRemove.contains(r);
@@ -553,10 +609,16 @@ namespace Engine2D::Rendering {
       );
 
       // Add all the renderers to their appropriate vectors
-      staticOpaqueRenderers.insert(staticOpaqueRenderers.end(), renderersToAdd.begin(), static_opaque_end.begin());
-      staticTransparentRenderers.insert(
-        staticTransparentRenderers.end(), static_opaque_end.begin(), static_end.begin()
-      );
+      for (const auto &renderer: std::ranges::subrange(renderersToAdd.begin(), static_opaque_end.begin())) {
+        auto &group = staticOpaqueGroups[renderer->staticGroup];
+        group.renderers.emplace_back(renderer);
+        group.changed = true;
+      }
+      for (const auto &renderer: std::ranges::subrange(static_opaque_end.begin(), static_end.begin())) {
+        auto &group = staticTransparentGroups[renderer->staticGroup];
+        group.renderers.emplace_back(renderer);
+        group.changed = true;
+      }
       opaqueRenderers.insert(opaqueRenderers.end(), static_end.begin(), opaque_end.begin());
       transparentRenderers.insert(transparentRenderers.end(), opaque_end.begin(), opaque_end.end());
     }
@@ -565,23 +627,21 @@ namespace Engine2D::Rendering {
 
     renderersToRemove.clear();
     renderersToAdd.clear();
-    SceneManager::ActiveScene()->particleSystemRegistry.prerender();
+    scene->particleSystemRegistry.prerender();
   }
 
-  void Renderer2D::opaquePass(const uint framebuffer) {
+  void Renderer2D::opaquePass(FrameSnapshot &snapshot) {
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSystem);
 
-    const auto &particleSystemRegistry = SceneManager::ActiveScene()->particleSystemRegistry;
-    if (opaqueRenderers.empty() && staticOpaqueRenderers.empty() && particleSystemRegistry.subrange.empty())
+    snapshot.opaque.flushList.clear();
+    const auto &particleSystemRegistry = scene->particleSystemRegistry;
+    if (opaqueRenderers.empty() && staticOpaqueGroups.empty() && particleSystemRegistry.subrange.empty())
       return;
 
     zSort = false;
 
-    // Render the static opaque sprites
-    buildAndRenderStaticBatch(
-      staticOpaqueRenderers, staticOpaqueBatchData, staticOpaqueFlushList,
-      staticOpaqueRenderers.size() != lastOpaqueStaticCount, staticOpaqueBatchVBO, framebuffer
-    );
+    // Extract the static opaque sprites
+    buildStaticGroups(staticOpaqueGroups, staticOpaqueBatch);
 
     // Prepare the non-static opaque sprites
     std::vector<Renderable2D *> renderables;
@@ -598,24 +658,22 @@ namespace Engine2D::Rendering {
       }
     );
 
-    buildAndRenderBatch(renderables, opaqueFlushList, particleCount, resortOpaque, framebuffer);
+    buildBatch(renderables, snapshot.opaque, particleCount, resortOpaque);
   }
 
-  void Renderer2D::transparentPass(const uint framebuffer) {
+  void Renderer2D::transparentPass(FrameSnapshot &snapshot) {
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSystem);
 
-    const auto &particleSystemRegistry = SceneManager::ActiveScene()->particleSystemRegistry;
-    if (opaqueRenderers.empty() && staticOpaqueRenderers.empty() &&
+    snapshot.transparent.flushList.clear();
+    const auto &particleSystemRegistry = scene->particleSystemRegistry;
+    if (transparentRenderers.empty() && staticTransparentGroups.empty() &&
         particleSystemRegistry.particleSystems.begin() == particleSystemRegistry.subrange.begin())
       return;
 
     zSort = true;
 
-    // Render the static transparent sprites
-    buildAndRenderStaticBatch(
-      staticTransparentRenderers, staticTransparentBatchData, staticTransparentFlushList,
-      staticTransparentRenderers.size() != lastTransparentStaticCount, staticTransparentBatchVBO, framebuffer
-    );
+    // Extract the static transparent sprites
+    buildStaticGroups(staticTransparentGroups, staticTransparentBatch);
 
     const auto transparentEnd = particleSystemRegistry.subrange.size() == 0
                                   ? particleSystemRegistry.particleSystems.end()
@@ -637,24 +695,73 @@ namespace Engine2D::Rendering {
       }
     );
 
-    buildAndRenderBatch(renderables, transparentFlushList, particleCount, true, framebuffer);
+    buildBatch(renderables, snapshot.transparent, particleCount, true);
   }
 
-  void Renderer2D::render(const uint framebuffer) {
+  void Renderer2D::extract(FrameSnapshot &snapshot) {
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSystem);
+
+    if (const auto camera = scene->MainCamera()) {
+      snapshot.view = camera->ViewMatrix();
+      snapshot.projection = camera->ProjectionMatrix();
+      snapshot.viewProjection = camera->ViewProjectionMatrix();
+    }
+
     updateAndSplitRenderList();
+    opaquePass(snapshot);
+    transparentPass(snapshot);
+
+    // The static batches rarely change, only copy them when they do
+    if (snapshot.staticOpaque.version != staticOpaqueBatch.version)
+      snapshot.staticOpaque = staticOpaqueBatch;
+    if (snapshot.staticTransparent.version != staticTransparentBatch.version)
+      snapshot.staticTransparent = staticTransparentBatch;
+  }
+
+  void Renderer2D::submit(const FrameSnapshot &snapshot, const uint framebuffer) {
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSystem);
+
+    if (!quadVAO)
+      initRenderData();
+
+    // Send the camera data to the shaders
+    glBindBuffer(GL_UNIFORM_BUFFER, cameraUBO);
+    void *ptr = glMapBufferRange(
+      GL_UNIFORM_BUFFER, 0, 3 * sizeof(glm::mat4), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT
+    );
+    if (ptr) {
+      memcpy(ptr, &snapshot.view, sizeof(glm::mat4));
+      memcpy(static_cast<char *>(ptr) + sizeof(glm::mat4), &snapshot.projection, sizeof(glm::mat4));
+      memcpy(static_cast<char *>(ptr) + 2 * sizeof(glm::mat4), &snapshot.viewProjection, sizeof(glm::mat4));
+      glUnmapBuffer(GL_UNIFORM_BUFFER);
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
     glBindVertexArray(quadVAO);
-    opaquePass(framebuffer);
-    transparentPass(framebuffer);
+    renderBatch(snapshot.staticOpaque, staticOpaqueBatchVBO, GL_STATIC_DRAW, framebuffer);
+    renderBatch(snapshot.opaque, batchVBO, GL_DYNAMIC_DRAW, framebuffer);
+    renderBatch(snapshot.staticTransparent, staticTransparentBatchVBO, GL_STATIC_DRAW, framebuffer);
+    renderBatch(snapshot.transparent, batchVBO, GL_DYNAMIC_DRAW, framebuffer);
     glBindVertexArray(0);
   }
 
+  void Renderer2D::render(const uint framebuffer) {
+    extract(immediateSnapshot);
+    submit(immediateSnapshot, framebuffer);
+  }
+
   void Renderer2D::addRenderer(SpriteRenderer *renderer) {
-    scene->resources.renderables.push_back(renderer);
+    scene->resources.addRenderable(renderer);
     renderersToAdd.push_back(renderer);
   }
 
   void Renderer2D::removeRenderer(SpriteRenderer *renderer) {
-    std::erase(scene->resources.renderables, renderer);
+    scene->resources.removeRenderable(renderer);
     renderersToRemove.insert(renderer);
+
+    // The renderer can be destroyed before the removal is applied, so its group is looked up while it is still valid
+    for (auto *groups: {&staticOpaqueGroups, &staticTransparentGroups})
+      if (const auto it = groups->find(renderer->staticGroup); it != groups->end())
+        it->second.changed = true;
   }
 }
@@ -4,12 +4,16 @@
 // Date: 25.07.2025
 //
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <ranges>
 
 #include "Engine2D/SceneManagement/Scene.hpp"
 #include "Engine/Macros/Profiling.hpp"
+#include "Engine/Profiling/FrameTelemetry.hpp"
 #include "Engine/Reflection/Serializer.hpp"
+#include "Engine/Threading/JobSystem.hpp"
 #include "Engine2D/Component2D.hpp"
 #include "Engine2D/Game2D.hpp"
 #include "Engine2D/Physics/Physics2D.hpp"
@@ -18,6 +22,11 @@
 #include "Engine2D/Rendering/SpriteRenderer.hpp"
 #include "Engine2D/SceneManagement/SceneManager.hpp"
 
+#define BEHAVIOUR_GRAIN_SIZE 64
+#define TRANSFORM_GRAIN_SIZE 256
+
+using Engine::Profiling::FrameTelemetry;
+
 namespace Engine2D {
   Scene::Scene()
     : Scene("default") {}
@@ -27,9 +36,13 @@ namespace Engine2D {
   }
 
   Scene::Scene(const std::string &name)
-    : name(name), cameraComponent(nullptr), initialized(false), loaded(false), renderingSystem() {
+    : name(name), cameraComponent(nullptr), initialized(false), loaded(false), dispatchListsDirty(true),
+      transformsDirty(false), transformOrderDirty(true), deltaTime(0), physicsAccumulator(0),
+      physicsSettings(Engine::Settings::Physics::defaults), renderingSystem() {
+    physicsSystem.scene = this;
     renderingSystem.scene = this;
     particleSystemRegistry.scene = this;
+    streamer.scene = this;
   }
 
   const std::string &Scene::Name() {
@@ -40,26 +53,140 @@ namespace Engine2D {
     cameraComponent = camera;
   }
 
+  WorldStreamer &Scene::Streamer() {
+    return streamer;
+  }
+
   Engine::Ptr<Rendering::Camera2D> Scene::MainCamera() const {
     return cameraComponent;
   }
 
   Engine::Ptr<Entity2D> Scene::Find(const std::string &name) const {
-    for (const auto &entity: entitiesToAdd)
-      if (entity->name == name)
-        return entity.get();
-    #if ENGINE_EDITOR
-    for (const auto &key: entitiesToAddAt | std::views::keys)
-      if (key->name == name)
-        return key.get();
-    #endif
-    for (const auto &entity: entities)
-      if (entity->name == name && !entity->destroyed)
-        return entity.get();
+    std::shared_lock lock(namesMutex);
+    if (const auto it = entitiesByName.find(name); it != entitiesByName.end())
+      for (const auto entity: it->second)
+        if (entity && !entity->destroyed && entity->name == name)
+          return entity;
     return nullptr;
   }
 
+  void Scene::indexName(Entity2D *entity) {
+    std::unique_lock lock(namesMutex);
+    addToNameIndex(entity);
+  }
+
+  void Scene::unindexName(Entity2D *entity) {
+    std::unique_lock lock(namesMutex);
+    removeFromNameIndex(entity);
+  }
+
+  void Scene::renameEntity(Entity2D *entity, const std::string &name) {
+    std::unique_lock lock(namesMutex);
+    removeFromNameIndex(entity);
+    entity->name = name;
+    addToNameIndex(entity);
+  }
+
+  void Scene::addToNameIndex(Entity2D *entity) {
+    entity->indexedName = entity->name;
+    auto &bucket = entitiesByName[entity->indexedName];
+    entity->nameIndex = bucket.size();
+    bucket.push_back(entity);
+  }
+
+  void Scene::removeFromNameIndex(const Entity2D *entity) {
+    const auto it = entitiesByName.find(entity->indexedName);
+    if (it == entitiesByName.end())
+      return;
+
+    // Only leave a hole, the bucket is compacted once during the next sync to keep the order of the other entities
+    auto &bucket = it->second;
+    if (entity->nameIndex >= bucket.size() || bucket[entity->nameIndex] != entity)
+      return;
+    bucket[entity->nameIndex] = nullptr;
+    namesToCompact.insert(entity->indexedName);
+  }
+
+  void Scene::indexEntity(Entity2D *entity) {
+    indexName(entity);
+    for (const auto &component: entity->allComponents)
+      registerComponent(component.get());
+  }
+
+  void Scene::unindexEntity(Entity2D *entity) {
+    unindexName(entity);
+    for (const auto &component: entity->allComponents)
+      unregisterComponent(component.get());
+  }
+
+  void Scene::registerComponent(Component2D *component) {
+    if (component->typeId >= componentsByType.size())
+      componentsByType.resize(component->typeId + 1);
+    auto &bucket = componentsByType[component->typeId];
+    component->typeIndex = bucket.size();
+    bucket.push_back(component);
+  }
+
+  void Scene::unregisterComponent(Component2D *component) {
+    if (component->typeId >= componentsByType.size())
+      return;
+
+    auto &bucket = componentsByType[component->typeId];
+    if (component->typeIndex >= bucket.size() || bucket[component->typeIndex] != component)
+      return;
+    bucket[component->typeIndex] = nullptr;
+    typesToCompact.insert(component->typeId);
+  }
+
+  void Scene::compactIndexes() {
+    std::unique_lock lock(namesMutex);
+    for (const auto &name: namesToCompact) {
+      const auto it = entitiesByName.find(name);
+      if (it == entitiesByName.end())
+        continue;
+      std::erase(it->second, nullptr);
+      if (it->second.empty())
+        entitiesByName.erase(it);
+      else
+        for (size_t i = 0; i < it->second.size(); ++i)
+          it->second[i]->nameIndex = i;
+    }
+    namesToCompact.clear();
+
+    for (const uint32_t typeId: typesToCompact) {
+      auto &bucket = componentsByType[typeId];
+      std::erase(bucket, nullptr);
+      for (size_t i = 0; i < bucket.size(); ++i)
+        bucket[i]->typeIndex = i;
+    }
+    typesToCompact.clear();
+  }
+
   void Scene::syncEntities() {
+    FrameTelemetry::ScopedStage stage(FrameTelemetry::Sync);
+
+    // Streamed chunks queue their entities to be added and removed with the others
+    streamer.update();
+
+    #if ENGINE_EDITOR
+    if (!entitiesToAdd.empty() || !entitiesToAddAt.empty() || !entitiesToRemove.empty() || !entitiesToDestroy.empty())
+    #else
+    if (!entitiesToAdd.empty() || !entitiesToRemove.empty() || !entitiesToDestroy.empty())
+    #endif
+    {
+      dispatchListsDirty = true;
+      transformOrderDirty = true;
+    }
+
+    #if ENGINE_EDITOR
+    // The editor renames entities by writing their name directly, move them to their new name before using the index
+    for (const auto &entity: entities)
+      if (entity->name != entity->indexedName && !entity->destroyed) {
+        unindexName(entity.get());
+        indexName(entity.get());
+      }
+    #endif
+
     for (auto &entity: entitiesToAdd) {
       entity->initialize();
       entities.emplace_back(std::move(entity));
@@ -73,35 +200,41 @@ namespace Engine2D {
     entitiesToAddAt.clear();
     #endif
 
-    #if MULTI_THREAD
-    for (auto entity: entitiesToDestroy) {
-      entity->free();
+    // With a render thread, destroyed entities are kept alive for a while in case the frame being drawn still uses them
+    const bool deferFree = Game2D::instance && Game2D::instance->renderThreadEnabled;
+    for (const auto &entity: entitiesToRemove) {
+      purgeActivations(entity.get());
+      entity->destroy();
+      if (!deferFree)
+        entitiesToDestroy.insert(entity);
+    }
+    entitiesToRemove.clear();
+
+    // Free all the entities first and compact the list once, erasing them one by one is quadratic for large waves
+    if (!entitiesToDestroy.empty()) {
+      for (const auto &entity: entitiesToDestroy)
+        entity->free();
       std::erase_if(
-        entities, [entity](const std::unique_ptr<Entity2D> &ent) {
-          return ent.get() == entity;
+        entities, [this](const std::unique_ptr<Entity2D> &entity) {
+          return entitiesToDestroy.contains(entity.get());
         }
       );
-    }
-    entitiesToDestroy.clear();
-    #endif
-    for (auto entity: entitiesToRemove) {
-      entity->destroy();
-      #if !MULTI_THREAD
-      entity->free();
       std::erase_if(
-        entities, [entity](const std::unique_ptr<Entity2D> &ent) {
-          return ent.get() == entity;
+        entitiesToInitialize, [this](Entity2D *entity) {
+          return entitiesToDestroy.contains(entity);
         }
       );
-      #endif
+      entitiesToDestroy.clear();
     }
-    entitiesToRemove.clear();
+
+    compactIndexes();
   }
 
   void Scene::addEntity(std::unique_ptr<Entity2D> entity) {
     if (!entity)
       return;
     entity->scene = this;
+    indexEntity(entity.get());
     entitiesToAdd.emplace_back(std::move(entity));
   }
 
@@ -111,6 +244,12 @@ namespace Engine2D {
     entitiesToRemove.insert(entity);
   }
 
+  void Scene::bindInput() const {
+    for (const auto &entity: entities)
+      for (const auto &behaviour: entity->behaviours)
+        behaviour->OnBindInput();
+  }
+
   void Scene::initialize() {
     if (initialized || loaded)
       return;
@@ -132,84 +271,412 @@ namespace Engine2D {
     );
   }
 
-  #if MULTI_THREAD
   void Scene::update() {
-    #else
-  void Scene::update() const {
-    #endif
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSystem);
+    FrameTelemetry::ScopedStage stage(FrameTelemetry::Update);
+
+    // Initialization can access anything, so it is always done serially, entities that are not active yet stay queued
+    // The queue is swapped out first since initializing a behaviour can queue other entities
+    std::vector<Entity2D *> pending;
+    pending.swap(entitiesToInitialize);
+    for (const auto entity: pending) {
+      if (entity->destroyed)
+        continue;
+      if (!entity->IsActive()) {
+        entitiesToInitialize.emplace_back(entity);
+        continue;
+      }
+
+      const auto behaviours = std::move(entity->behavioursToInitialize);
+      entity->behavioursToInitialize.clear();
+      for (const auto &behaviour: behaviours) {
+        behaviour->OnInitialize();
+        behaviour->OnBindInput();
+      }
+    }
+
+    for (auto it = entitiesToExpire.begin(); it != entitiesToExpire.end();) {
+      const auto entity = *it;
+      entity->timeToLive -= Game2D::DeltaTime();
+      if (entity->timeToLive > 0.0f) {
+        ++it;
+        continue;
+      }
+      entitiesToDestroy.insert(entity);
+      it = entitiesToExpire.erase(it);
+    }
+
+    buildDispatchLists();
+
+    // Read only behaviours run first so that they all see the state of the scene from the previous frame
+    Engine::Threading::JobSystem::ParallelFor(
+      readOnlyUpdates.size(), BEHAVIOUR_GRAIN_SIZE, [this](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i)
+          if (const auto &behaviour = readOnlyUpdates[i]; behaviour && behaviour->IsActive())
+            behaviour->OnUpdate();
+      }
+    );
+
+    // A transform change propagates to the children, so each hierarchy is updated by a single worker
+    Engine::Threading::JobSystem::ParallelFor(
+      hierarchyOffsets.size() - 1, BEHAVIOUR_GRAIN_SIZE, [this](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i)
+          for (size_t j = hierarchyOffsets[i]; j < hierarchyOffsets[i + 1]; ++j)
+            if (const auto &behaviour = ownEntityUpdates[j]; behaviour && behaviour->IsActive())
+              behaviour->OnUpdate();
+      }
+    );
+
+    // Behaviours that write shared state are updated in entity order to stay deterministic
+    for (size_t i = 0; i < sharedUpdates.size(); ++i)
+      if (const auto behaviour = sharedUpdates[i]; behaviour && behaviour->IsActive())
+        behaviour->OnUpdate();
+
+    propagateTransforms();
+  }
+
+  void Scene::buildDispatchLists() {
+    if (!dispatchListsDirty) {
+      // Only activations happened, the activated behaviours are added in the order of their entities to stay
+      // deterministic even if they were activated from worker threads
+      std::scoped_lock lock(activationMutex);
+      if (activatedEntities.empty() && activatedBehaviours.empty())
+        return;
+
+      ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerFunction);
+
+      std::ranges::sort(activatedEntities, {}, &Entity2D::id);
+      std::ranges::sort(activatedBehaviours, {}, [](const Behaviour *behaviour) { return behaviour->entity->id; });
+      bool added = true;
+      for (size_t i = 0; added && i < activatedEntities.size(); ++i)
+        added = addEntityToDispatchLists(activatedEntities[i]);
+      for (size_t i = 0; added && i < activatedBehaviours.size(); ++i)
+        added = addToDispatchLists(activatedBehaviours[i]);
+      activatedEntities.clear();
+      activatedBehaviours.clear();
+      if (added)
+        return;
+
+      // Shared and fixed updates run in entity order, which only a rebuild can restore
+      dispatchListsDirty = true;
+    }
+
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSubSystem);
 
+    dispatchListsDirty = false;
+    {
+      // The rebuild adds every active behaviour, including the queued ones
+      std::scoped_lock lock(activationMutex);
+      activatedEntities.clear();
+      activatedBehaviours.clear();
+    }
+    readOnlyUpdates.clear();
+    ownEntityUpdates.clear();
+    sharedUpdates.clear();
+    fixedUpdates.clear();
+    hierarchyOffsets.assign(1, 0);
+    hierarchyRanges.clear();
+    for (const auto &entity: entities)
+      for (const auto &behaviour: entity->behaviours)
+        behaviour->dispatched = false;
+
+    // Inactive entities and behaviours are left out, they are added to the lists when they are activated
     for (const auto &entity: entities) {
-      if (entity->IsActive()) {
-        for (const auto &behaviour: entity->behavioursToInitialize) {
-          behaviour->OnInitialize();
-          behaviour->OnBindInput();
+      if (!entity->IsActive())
+        continue;
+
+      for (const auto &behaviour: entity->behaviours) {
+        if (!behaviour->active)
+          continue;
+        behaviour->dispatched = true;
+        if (behaviour->hooks & Behaviour::FixedUpdateHook)
+          fixedUpdates.emplace_back(behaviour);
+        if (behaviour->hooks & Behaviour::UpdateHook) {
+          if (const auto access = behaviour->Access(); access == Behaviour::ReadOnly)
+            readOnlyUpdates.emplace_back(behaviour);
+          else if (access == Behaviour::Shared)
+            sharedUpdates.emplace_back(behaviour);
         }
-        entity->behavioursToInitialize.clear();
-        for (const auto &behaviour: entity->behaviours)
-          if (behaviour->IsActive())
-            behaviour->OnUpdate();
       }
-      #if MULTI_THREAD
-      else if (entity->destroyed) {
-        entity->timeToLive -= Game2D::DeltaTime();
-        if (entity->timeToLive <= 0.0f)
-          entitiesToDestroy.insert(entity.get());
+
+      // Own entity behaviours are grouped by hierarchy, starting from each root
+      if (!entity->transform->parent) {
+        addHierarchyToDispatchLists(entity.get());
+        if (ownEntityUpdates.size() > hierarchyOffsets.back()) {
+          hierarchyRanges[entity.get()] = hierarchyOffsets.size() - 1;
+          hierarchyOffsets.emplace_back(ownEntityUpdates.size());
+        }
+      }
+    }
+  }
+
+  void Scene::addHierarchyToDispatchLists(const Entity2D *entity) {
+    for (const auto &behaviour: entity->behaviours)
+      if (
+        behaviour->active && (behaviour->hooks & Behaviour::UpdateHook) && behaviour->Access() == Behaviour::OwnEntity
+      ) {
+        behaviour->dispatched = true;
+        ownEntityUpdates.emplace_back(behaviour);
       }
-      #endif
+    // The children of an inactive entity are inactive as well
+    for (const auto &child: entity->transform->children)
+      if (child && child->IsActive())
+        addHierarchyToDispatchLists(child.get());
+  }
+
+  void Scene::queueActivation(Entity2D *entity) {
+    std::scoped_lock lock(activationMutex);
+    activatedEntities.emplace_back(entity);
+  }
+
+  void Scene::queueActivation(Behaviour *behaviour) {
+    std::scoped_lock lock(activationMutex);
+    activatedBehaviours.emplace_back(behaviour);
+  }
+
+  bool Scene::addToDispatchLists(Behaviour *behaviour) {
+    // Deactivated behaviours stay in the lists and are skipped, so they are only added once
+    if (behaviour->dispatched || !behaviour->IsActive())
+      return true;
+
+    const bool update = behaviour->hooks & Behaviour::UpdateHook;
+    const auto access = behaviour->Access();
+    if ((behaviour->hooks & Behaviour::FixedUpdateHook) || (update && access == Behaviour::Shared))
+      return false;
+
+    behaviour->dispatched = true;
+    if (!update)
+      return true;
+    if (access == Behaviour::ReadOnly) {
+      readOnlyUpdates.emplace_back(behaviour);
+      return true;
+    }
+
+    // A hierarchy is updated by a single worker, so the behaviour goes at the end of the range of its root
+    const Entity2D *root = behaviour->entity.get();
+    while (root->transform->parent)
+      root = root->transform->parent.get();
+
+    if (const auto it = hierarchyRanges.find(root); it != hierarchyRanges.end()) {
+      const size_t range = it->second;
+      ownEntityUpdates.insert(
+        ownEntityUpdates.begin() + static_cast<std::ptrdiff_t>(hierarchyOffsets[range + 1]), behaviour
+      );
+      for (size_t i = range + 1; i < hierarchyOffsets.size(); ++i)
+        ++hierarchyOffsets[i];
+    } else {
+      hierarchyRanges[root] = hierarchyOffsets.size() - 1;
+      ownEntityUpdates.emplace_back(behaviour);
+      hierarchyOffsets.emplace_back(ownEntityUpdates.size());
+    }
+    return true;
+  }
+
+  bool Scene::addEntityToDispatchLists(const Entity2D *entity) {
+    if (!entity->IsActive())
+      return true;
+
+    for (const auto &behaviour: entity->behaviours)
+      if (!addToDispatchLists(behaviour.get()))
+        return false;
+    for (const auto &child: entity->transform->children)
+      if (child && !addEntityToDispatchLists(child.get()))
+        return false;
+    return true;
+  }
+
+  void Scene::purgeActivations(const Entity2D *entity) {
+    std::scoped_lock lock(activationMutex);
+    if (activatedEntities.empty() && activatedBehaviours.empty())
+      return;
+
+    std::erase(activatedEntities, entity);
+    for (const auto &behaviour: entity->behaviours)
+      std::erase(activatedBehaviours, behaviour.get());
+  }
+
+  void Scene::removeFromDispatchLists(const Engine::Ptr<Behaviour> &behaviour) {
+    {
+      std::scoped_lock lock(activationMutex);
+      std::erase(activatedBehaviours, behaviour.get());
     }
+    // The lists might be iterated at this moment, so the behaviour is only cleared, the lists are compacted on rebuild
+    for (auto *list: {&readOnlyUpdates, &ownEntityUpdates, &sharedUpdates, &fixedUpdates})
+      std::ranges::replace(*list, behaviour, Engine::Ptr<Behaviour>());
+    dispatchListsDirty = true;
+  }
+
+  void Scene::propagateTransforms(const uint64_t physicsStep) {
+    if (!transformsDirty)
+      return;
+
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSubSystem);
+
+    transformsDirty = false;
+    buildTransformNodes();
+
+    // Parents are updated before their children, so each transform is placed in the already updated world values of
+    // its parent instead of walking up its hierarchy, and hierarchies never share a transform
+    Engine::Threading::JobSystem::ParallelFor(
+      transformHierarchyOffsets.size() - 1, TRANSFORM_GRAIN_SIZE,
+      [this, physicsStep](const size_t begin, const size_t end) {
+        for (size_t i = transformHierarchyOffsets[begin]; i < transformHierarchyOffsets[end]; ++i) {
+          const auto [transform, parent] = transformNodes[i];
+          const bool parentUpdated = parent >= 0 && transformsUpdated[parent];
+          transformsUpdated[i] = false;
+          if (!transform->worldDirty && !parentUpdated)
+            continue;
+
+          // A child moved by the body it is attached to records where it was before the step like the body did, the
+          // mark is passed down since parents are visited first
+          if (
+            physicsStep != 0 && parentUpdated && transform->previousPhysicsStep != physicsStep &&
+            transformNodes[parent].transform->previousPhysicsStep == physicsStep
+          ) {
+            transform->previousWorldPosition = transform->worldPosition;
+            transform->previousWorldRotation = transform->worldRotation;
+            transform->previousPhysicsStep = physicsStep;
+          }
+
+          const auto parentWorld = parent >= 0 ? transformNodes[parent].transform->world() : Transform2D::World{};
+          transformsUpdated[i] = transform->applyWorld(transform->composeWorld(parentWorld));
+        }
+      }
+    );
+  }
+
+  void Scene::buildTransformNodes() {
+    if (!transformOrderDirty)
+      return;
+
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSubSystem);
+
+    transformOrderDirty = false;
+    transformNodes.clear();
+    transformHierarchyOffsets.assign(1, 0);
+    for (const auto &entity: entities)
+      if (!entity->transform->parent) {
+        addHierarchyToTransformNodes(entity.get(), -1);
+        transformHierarchyOffsets.emplace_back(transformNodes.size());
+      }
+    transformsUpdated.resize(transformNodes.size());
+  }
+
+  void Scene::addHierarchyToTransformNodes(const Entity2D *entity, const int32_t parent) {
+    const auto index = static_cast<int32_t>(transformNodes.size());
+    transformNodes.push_back({entity->transform.get(), parent});
+    for (const auto &child: entity->transform->children)
+      if (child)
+        addHierarchyToTransformNodes(child.get(), index);
+
+    entity->transform->hierarchyIndex = static_cast<uint32_t>(index);
+    entity->transform->hierarchyEnd = static_cast<uint32_t>(transformNodes.size());
   }
 
   void Scene::fixedUpdate() {
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSystem);
 
-    Game2D::instance->physicsAccumulator += Game2D::DeltaTime();
-    const float fixedDeltaTime = Engine::Settings::Physics::FixedDeltaTime();
-    while (Game2D::instance->physicsAccumulator >= fixedDeltaTime) {
-      for (const auto &entity: entities)
-        if (entity->IsActive())
-          for (const auto &behaviour: entity->behaviours)
-            if (behaviour->IsActive())
-              behaviour->OnFixedUpdate();
-      physicsSystem.step();
-      Game2D::instance->physicsAccumulator -= fixedDeltaTime;
+    physicsAccumulator += Game2D::DeltaTime();
+    const float fixedDeltaTime = physicsSettings.fixedDeltaTime;
+    const uint maxSubsteps = physicsSettings.maxSubsteps;
+    for (uint substeps = 0; physicsAccumulator >= fixedDeltaTime; ++substeps) {
+      // Drop the time that does not fit in the budget, otherwise a slow frame makes the next one even slower
+      if (substeps == maxSubsteps) {
+        physicsAccumulator = std::fmod(physicsAccumulator, fixedDeltaTime);
+        break;
+      }
+
+      {
+        FrameTelemetry::ScopedStage stage(FrameTelemetry::FixedUpdate);
+        buildDispatchLists();
+        for (size_t i = 0; i < fixedUpdates.size(); ++i)
+          if (const auto behaviour = fixedUpdates[i]; behaviour && behaviour->IsActive())
+            behaviour->OnFixedUpdate();
+        propagateTransforms();
+      }
+      {
+        FrameTelemetry::ScopedStage stage(FrameTelemetry::Physics);
+        physicsSystem.step();
+        propagateTransforms();
+      }
+      physicsAccumulator -= fixedDeltaTime;
     }
+
+    // The leftover time is used to interpolate the rendered transforms between the last two steps
+    physicsSystem.interpolation = physicsAccumulator / fixedDeltaTime;
   }
 
-  void Scene::animate() const {
+  void Scene::animate() {
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSystem);
+    FrameTelemetry::ScopedStage stage(FrameTelemetry::Animate);
 
     animationSystem.update();
+    propagateTransforms();
   }
 
-  void Scene::render() {
+  void Scene::extractFrame(Rendering::FrameSnapshot &snapshot) {
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSystem);
+    FrameTelemetry::ScopedStage stage(FrameTelemetry::Extract);
+
+    // Transforms can also be moved outside the update, by the editor or between frames
+    propagateTransforms();
+    snapshot.scene = this;
+    snapshot.frame = FrameTelemetry::frameIndex.load(std::memory_order_relaxed);
+    snapshot.empty = entities.empty();
+    snapshot.cameraActive = false;
 
     // Make sure there is something to render
-    if (!entities.empty()) {
-      if (const auto cam = SceneManager::ActiveScene()->MainCamera(); cam->Entity()->IsActive() && cam->IsActive()) {
+    if (!snapshot.empty)
+      if (const auto cam = MainCamera(); cam && cam->Entity()->IsActive() && cam->IsActive()) {
         cam->updateCamera();
-        renderingSystem.render();
+        renderingSystem.extract(snapshot);
+        snapshot.cameraActive = true;
       }
+  }
 
-      // Prepare the next frame
-      glfwSwapBuffers(Game2D::instance->window);
-      glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    }
+  void Scene::render(const Rendering::FrameSnapshot &snapshot) {
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSystem);
+    FrameTelemetry::ScopedStage stage(FrameTelemetry::Submit, snapshot.frame);
+
+    if (snapshot.empty)
+      return;
+
+    if (snapshot.cameraActive)
+      renderingSystem.submit(snapshot);
+
+    // Prepare the next frame
+    glfwSwapBuffers(Game2D::instance->window);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  }
+
+  void Scene::render() {
+    extractFrame(renderingSystem.immediateSnapshot);
+    render(renderingSystem.immediateSnapshot);
   }
 
   void Scene::renderHeadless() {
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSystem);
 
-    // Make sure there is something to render
-    if (!entities.empty())
-      if (const auto cam = SceneManager::ActiveScene()->MainCamera(); cam->Entity()->IsActive() && cam->IsActive()) {
-        cam->updateCamera();
-        renderingSystem.render();
-      }
+    extractFrame(renderingSystem.immediateSnapshot);
+    if (renderingSystem.immediateSnapshot.cameraActive) {
+      FrameTelemetry::ScopedStage stage(FrameTelemetry::Submit);
+      renderingSystem.submit(renderingSystem.immediateSnapshot);
+    }
   }
 
   void Scene::destroy() {
+    streamer.clear();
+    {
+      std::scoped_lock lock(activationMutex);
+      activatedEntities.clear();
+      activatedBehaviours.clear();
+    }
+    // Every entity is about to be destroyed, there is no need to remove them from the indexes one by one
+    entitiesByName.clear();
+    componentsByType.clear();
+    namesToCompact.clear();
+    typesToCompact.clear();
+    entitiesToInitialize.clear();
     for (const auto &entity: entitiesToAdd) {
       entity->destroy();
       entity->free();
@@ -220,11 +687,14 @@ namespace Engine2D {
     }
     entities.clear();
     entitiesToAdd.clear();
+    dispatchListsDirty = true;
+    transformNodes.clear();
+    transformOrderDirty = true;
   }
 
   void Scene::makeAllEntitiesDirty() const {
     for (const auto &entity: entities) {
-      entity->Transform()->dirty = true;
+      entity->Transform()->visibility = 0;
 
       if (const auto &renderer = entity->GetComponents<Rendering::Renderable2D>(); !renderer.empty())
         for (const auto &comp: renderer)
@@ -234,6 +704,8 @@ namespace Engine2D {
 
   void Scene::OnDeserialize(const Engine::Reflection::Format format, const Engine::JSON &json) {
     std::erase(entities, nullptr);
+    dispatchListsDirty = true;
+    transformOrderDirty = true;
 
     int i = 0;
     for (auto it = entities.begin(); it != entities.end();) {
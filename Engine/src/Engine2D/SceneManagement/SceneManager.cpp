@@ -5,14 +5,25 @@
 //
 
 #include <ranges>
+#include <stdexcept>
 
 #include "Engine2D/SceneManagement/SceneManager.hpp"
 #include "Engine/Log.hpp"
+#include "Engine/Macros/Profiling.hpp"
 #include "Engine/Reflection/Deserializer.hpp"
 #include "Engine/Reflection/Serializer.hpp"
 #include "Engine2D/Game2D.hpp"
 
 namespace Engine2D {
+  SceneManager::ScopedScene::ScopedScene(const Engine::Ptr<Scene> &scene)
+    : previous(Engine::Threading::JobSystem::Context()) {
+    Engine::Threading::JobSystem::SetContext(scene.get());
+  }
+
+  SceneManager::ScopedScene::~ScopedScene() {
+    Engine::Threading::JobSystem::SetContext(previous);
+  }
+
   Engine::Ptr<Scene> SceneManager::CreateScene(const std::string &name) {
     if (scenes.contains(name))
       return Engine::Log::Error("Scene with name: " + name + " already exists!");
@@ -22,40 +33,20 @@ namespace Engine2D {
     return ptr;
   }
 
-  std::mutex syncMutex;
-
   Engine::Ptr<Scene> SceneManager::LoadScene(const std::string &name, const std::string &path) {
-    {
-      std::unique_lock controlLock(Game2D::instance->controlMutex); {
-        std::scoped_lock syncLock(syncMutex);
-        Game2D::instance->renderThreadCallback = [&] {
-          auto loadedScene = Engine::Reflection::Deserializer::FromJsonFromFile<std::unique_ptr<Scene>>(path);
-
-          const bool isActiveScene = activeScene && activeScene->name == name;
-
-          if (scenes.contains(name)) {
-            scenes.at(name)->destroy();
-            scenes.erase(name);
-          }
-
-          loadedScene->name = name;
-          loadedScene->loaded = true;
-          scenes.emplace(name, std::move(loadedScene));
-
-          if (isActiveScene)
-            activeScene = scenes.at(name).get();
-        };
-        Game2D::instance->callbackPending = true;
-        Game2D::instance->cv.notify_one(); // wake render thread
-      }
-      // now wait for render thread to consume the callback
-      Game2D::instance->controlCV.wait(
-        controlLock, [] {
-          return !Game2D::instance->callbackPending;
-        }
-      );
-      return scenes.at(name).get();
-    }
+    // The resources of the scene queue their own uploads, so the scene does not need to be read on the render thread
+    return addLoadedScene(name, readScene(path));
+  }
+
+  std::future<Engine::Ptr<Scene>> SceneManager::LoadSceneAsync(const std::string &name, const std::string &path) {
+    PendingLoad &load = pendingLoads.emplace_back();
+    load.name = name;
+    load.scene = std::async(std::launch::async, readScene, path);
+    return load.loaded.get_future();
+  }
+
+  bool SceneManager::IsLoading() {
+    return !pendingLoads.empty();
   }
 
   void SceneManager::SaveScene(
@@ -86,40 +77,61 @@ namespace Engine2D {
   void SceneManager::SaveActiveScene(
     const std::string &path, const Engine::Reflection::Format format, const bool prettyPrint, const char indentChar
   ) {
-    if (activeScene)
-      SaveScene(activeScene, path.empty() ? activeScene->name + ".json" : path, format, prettyPrint, indentChar);
+    if (const auto scene = activeScene.load())
+      SaveScene(scene, path.empty() ? scene->name + ".json" : path, format, prettyPrint, indentChar);
   }
 
   void SceneManager::UnloadScene(const std::string &name) {
-    if (scenes.contains(name))
+    if (scenes.contains(name)) {
+      Game2D::waitForRenderedFrame();
       scenes.at(name)->destroy();
+    }
   }
 
   void SceneManager::DestroyScene(const std::string &name) {
     if (scenes.contains(name)) {
-      if (scenes.at(name).get() == activeScene)
+      if (scenes.at(name).get() == activeScene.load())
         activeScene = nullptr;
+      // The render thread might still be drawing a frame extracted from the scene
+      Game2D::waitForRenderedFrame();
       scenes.at(name)->destroy();
       scenes.erase(name);
     }
   }
 
   void SceneManager::DestroyAllScenes() {
+    // Wait for the scenes still loading so that their thread does not outlive the resources it uses
+    for (auto &load: pendingLoads) {
+      try {
+        if (const auto scene = load.scene.get())
+          scene->destroy();
+        else
+          Engine::Log::Error("Scene " + load.name + " could not be loaded");
+        load.loaded.set_value(nullptr);
+      } catch (...) {
+        load.loaded.set_exception(std::current_exception());
+      }
+    }
+    pendingLoads.clear();
+
     while (!scenes.empty())
       DestroyScene(scenes.begin()->first);
   }
 
   void SceneManager::SetActiveScene(const std::string &name) {
     if (scenes.contains(name)) {
-      activeScene = scenes.at(name).get();
-      if (!activeScene->loaded)
-        activeScene->initialize();
+      const auto scene = scenes.at(name).get();
+      activeScene = scene;
+      if (!scene->loaded)
+        scene->initialize();
     } else
       activeScene = nullptr;
   }
 
   Engine::Ptr<Scene> SceneManager::ActiveScene() {
-    return activeScene;
+    if (const auto scene = steppedScene())
+      return scene;
+    return activeScene.load();
   }
 
   Engine::Ptr<Scene> SceneManager::GetScene(const std::string &name) {
@@ -132,4 +144,57 @@ namespace Engine2D {
   std::unique_ptr<Scene> &SceneManager::getSceneRef(const std::string &name) {
     return scenes.at(name);
   }
+
+  std::unique_ptr<Scene> SceneManager::readScene(const std::string &path) {
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerFunction);
+    return Engine::Reflection::Deserializer::FromJsonFromFile<std::unique_ptr<Scene>>(path);
+  }
+
+  Engine::Ptr<Scene> SceneManager::addLoadedScene(const std::string &name, std::unique_ptr<Scene> scene) {
+    // The scene it would have replaced is kept
+    if (!scene)
+      return Engine::Log::Error("Scene " + name + " could not be loaded");
+
+    const Scene *active = activeScene.load();
+    const bool isActiveScene = active && active->name == name;
+
+    if (scenes.contains(name)) {
+      // The render thread might still be drawing a frame extracted from the replaced scene
+      Game2D::waitForRenderedFrame();
+      scenes.at(name)->destroy();
+      scenes.erase(name);
+    }
+
+    scene->name = name;
+    scene->loaded = true;
+    // Input is global, so it is only bound once the scene is back on the update thread
+    scene->bindInput();
+    const auto ptr = scenes.emplace(name, std::move(scene)).first->second.get();
+
+    if (isActiveScene)
+      activeScene = ptr;
+    return ptr;
+  }
+
+  void SceneManager::commitLoadedScenes() {
+    // Scenes are added in the order they were requested so that the last request for a name wins
+    for (auto it = pendingLoads.begin(); it != pendingLoads.end();) {
+      if (it->scene.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        break;
+
+      try {
+        auto scene = it->scene.get();
+        if (!scene)
+          throw std::runtime_error("Scene " + it->name + " could not be loaded");
+        it->loaded.set_value(addLoadedScene(it->name, std::move(scene)));
+      } catch (...) {
+        it->loaded.set_exception(std::current_exception());
+      }
+      it = pendingLoads.erase(it);
+    }
+  }
+
+  Scene *SceneManager::steppedScene() {
+    return static_cast<Scene *>(Engine::Threading::JobSystem::Context());
+  }
 } // Engine2D
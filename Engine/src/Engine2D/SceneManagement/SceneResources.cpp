@@ -72,4 +72,21 @@ namespace Engine2D {
       }
     }
   }
+
+  void SceneResources::addRenderable(Rendering::Renderable2D *renderable) {
+    renderable->resourceIndex = renderables.size();
+    renderables.push_back(renderable);
+  }
+
+  void SceneResources::removeRenderable(Rendering::Renderable2D *renderable) {
+    // Swap the renderable with the last one so that removing it does not shift the whole list
+    const size_t index = renderable->resourceIndex;
+    if (index >= renderables.size() || renderables[index] != renderable)
+      return;
+    if (index != renderables.size() - 1) {
+      renderables[index] = renderables.back();
+      renderables[index]->resourceIndex = index;
+    }
+    renderables.pop_back();
+  }
 } // Engine2D
@@ -0,0 +1,381 @@
+//
+// WorldStreamer.cpp
+// Author: Antoine Bastide
+// Date: 16.10.2026
+//
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <ranges>
+#include <tuple>
+
+#include "Engine2D/SceneManagement/WorldStreamer.hpp"
+#include "Engine/Log.hpp"
+#include "Engine/Data/JsonParser.hpp"
+#include "Engine/Macros/Profiling.hpp"
+#include "Engine/Reflection/Deserializer.hpp"
+#include "Engine/Reflection/Serializer.hpp"
+#include "Engine2D/Rendering/Camera2D.hpp"
+#include "Engine2D/Rendering/Renderable2D.hpp"
+#include "Engine2D/Rendering/Sprite.hpp"
+#include "Engine2D/SceneManagement/Scene.hpp"
+
+namespace Engine2D {
+  WorldStreamer::WorldStreamer()
+    : scene(nullptr), chunkSize(32.0f), loadRadius(1), unloadRadius(2), unloadMode(UnloadMode::Destroy),
+      maxLoadedChunks(0), maxConcurrentLoads(2), commitBudget(std::chrono::milliseconds(2)), nextGroup(1) {}
+
+  WorldStreamer::~WorldStreamer() {
+    clear();
+  }
+
+  void WorldStreamer::Enable(const std::string &directory) {
+    if (this->directory != directory)
+      clear();
+    this->directory = directory;
+  }
+
+  void WorldStreamer::Disable() {
+    clear();
+    directory.clear();
+  }
+
+  void WorldStreamer::SaveChunks(const std::string &directory, const std::vector<Engine::Ptr<Entity2D>> &roots) const {
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerFunction);
+
+    // Entities are serialized through the pointer that owns them so that chunk files use the format of scene files
+    std::unordered_map<const Entity2D *, const std::unique_ptr<Entity2D> *> owners;
+    owners.reserve(scene->entities.size());
+    for (const auto &entity: scene->entities)
+      if (!entity->destroyed)
+        owners.emplace(entity.get(), &entity);
+
+    std::vector<Entity2D *> toSave;
+    if (roots.empty()) {
+      const auto camera = scene->MainCamera();
+      const Entity2D *cameraEntity = camera ? camera->Entity().get() : nullptr;
+      for (const auto &entity: scene->entities)
+        if (!entity->destroyed && !entity->transform->Parent() && entity.get() != cameraEntity)
+          toSave.emplace_back(entity.get());
+    } else
+      for (const auto &root: roots)
+        if (root && owners.contains(root.get()))
+          toSave.emplace_back(root.get());
+
+    // The entities of each chunk with the index of their parent in the chunk, parents come before their children
+    std::unordered_map<uint64_t, std::vector<std::pair<Entity2D *, int>>> entitiesPerChunk;
+    for (const auto root: toSave) {
+      auto &entities = entitiesPerChunk[key(ChunkOf(root->transform->WorldPosition()))];
+      const size_t first = entities.size();
+      entities.emplace_back(root, -1);
+      for (size_t i = first; i < entities.size(); ++i) {
+        const Entity2D *entity = entities[i].first;
+        for (const auto &child: *entity->transform)
+          if (child && owners.contains(child.get()))
+            entities.emplace_back(child.get(), static_cast<int>(i));
+      }
+    }
+
+    std::filesystem::create_directories(directory);
+    for (const auto &[chunk, entities]: entitiesPerChunk) {
+      SceneResources resources;
+      Engine::JSON entitiesJSON = Engine::JSON::Array();
+      for (const auto &[entity, parent]: entities) {
+        Engine::JSON entityJSON = Engine::Reflection::Serializer::ToJson(*owners.at(entity));
+        entityJSON.At("data").At("transform").At("data")["parent"] = parent;
+        entitiesJSON.PushBack(entityJSON);
+
+        for (const auto &component: entity->allComponents)
+          if (const auto renderable = dynamic_cast<Rendering::Renderable2D *>(component.get());
+            renderable && renderable->sprite && renderable->sprite->texture)
+            resources.renderables.emplace_back(renderable);
+      }
+
+      Engine::JSON chunkJSON = Engine::JSON::Object();
+      resources.OnSerialize(Engine::Reflection::Format::JSON, chunkJSON["resources"]);
+      chunkJSON["entities"] = entitiesJSON;
+      std::ofstream(chunkPath(directory, coordinates(chunk))) << chunkJSON.Dump();
+    }
+  }
+
+  void WorldStreamer::SetChunkSize(const float size) {
+    chunkSize = std::max(size, 1.0f);
+  }
+
+  void WorldStreamer::SetLoadRadius(const int radius) {
+    loadRadius = std::max(radius, 0);
+    unloadRadius = std::max(unloadRadius, loadRadius);
+  }
+
+  void WorldStreamer::SetUnloadRadius(const int radius) {
+    unloadRadius = std::max(radius, loadRadius);
+  }
+
+  void WorldStreamer::SetUnloadMode(const UnloadMode mode) {
+    unloadMode = mode;
+  }
+
+  void WorldStreamer::SetMaxLoadedChunks(const size_t count) {
+    maxLoadedChunks = count;
+  }
+
+  void WorldStreamer::SetMaxConcurrentLoads(const size_t count) {
+    maxConcurrentLoads = std::max<size_t>(count, 1);
+  }
+
+  void WorldStreamer::SetCommitBudget(const float milliseconds) {
+    commitBudget = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<float, std::milli>(std::max(milliseconds, 0.0f))
+    );
+  }
+
+  glm::ivec2 WorldStreamer::ChunkOf(const glm::vec2 position) const {
+    return glm::ivec2(glm::floor(position / chunkSize));
+  }
+
+  bool WorldStreamer::IsLoaded(const glm::ivec2 chunk) const {
+    const auto it = chunks.find(key(chunk));
+    return it != chunks.end() && it->second.state == State::Loaded;
+  }
+
+  size_t WorldStreamer::LoadedChunkCount() const {
+    return chunks.size();
+  }
+
+  bool WorldStreamer::Enabled() const {
+    return !directory.empty();
+  }
+
+  void WorldStreamer::update() {
+    if (directory.empty())
+      return;
+
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSystem);
+
+    // Drop the chunks that were unloaded while they were being read once the read is done
+    std::erase_if(
+      abandoned, [](std::future<ChunkData> &loading) {
+        if (loading.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+          return false;
+        try {
+          auto data = loading.get();
+          discard(data, 0);
+        } catch (...) {}
+        return true;
+      }
+    );
+
+    const auto camera = scene->MainCamera();
+    if (!camera)
+      return;
+
+    const glm::ivec2 center = ChunkOf(camera->Entity()->transform->WorldPosition());
+    unloadChunks(center);
+    requestChunks(center);
+    commitChunks();
+  }
+
+  void WorldStreamer::clear() {
+    for (auto &chunk: chunks | std::views::values) {
+      if (chunk.state == State::Loading)
+        abandoned.emplace_back(std::move(chunk.loading));
+      else
+        discard(chunk.data, chunk.added);
+    }
+    chunks.clear();
+
+    for (auto &loading: abandoned)
+      try {
+        auto data = loading.get();
+        discard(data, 0);
+      } catch (...) {}
+    abandoned.clear();
+  }
+
+  void WorldStreamer::requestChunks(const glm::ivec2 center) {
+    size_t loading = abandoned.size();
+    for (const auto &chunk: chunks | std::views::values)
+      loading += chunk.state == State::Loading;
+
+    // Walk the rings around the center so that the closest chunks are read first
+    for (int ring = 0; ring <= loadRadius; ++ring)
+      for (int y = -ring; y <= ring; ++y)
+        for (int x = -ring; x <= ring; x += std::abs(y) == ring ? 1 : 2 * ring) {
+          const glm::ivec2 coordinates = center + glm::ivec2(x, y);
+          if (const auto it = chunks.find(key(coordinates)); it != chunks.end()) {
+            // Deactivated chunks are kept in memory, they only need to be turned back on
+            if (Chunk &chunk = it->second; chunk.state == State::Inactive) {
+              for (const auto &root: chunk.roots)
+                if (root.valid())
+                  root->SetActive(true);
+              chunk.state = State::Loaded;
+            }
+            continue;
+          }
+
+          if (loading >= maxConcurrentLoads || (maxLoadedChunks > 0 && chunks.size() >= maxLoadedChunks))
+            continue;
+
+          Chunk &chunk = chunks[key(coordinates)];
+          chunk.group = nextGroup++;
+          chunk.loading = std::async(std::launch::async, readChunk, chunkPath(directory, coordinates), chunk.group);
+          ++loading;
+        }
+  }
+
+  void WorldStreamer::commitChunks() {
+    using namespace std::chrono;
+
+    const auto start = steady_clock::now();
+    bool added = false;
+    for (auto &chunk: chunks | std::views::values) {
+      if (chunk.state == State::Loading) {
+        if (chunk.loading.wait_for(seconds(0)) != std::future_status::ready)
+          continue;
+
+        // A chunk that can not be read is treated as empty so that it is not read again every frame
+        try {
+          chunk.data = chunk.loading.get();
+        } catch (const std::exception &e) {
+          Engine::Log::Error("WorldStreamer: Failed to read chunk: " + std::string(e.what()));
+        }
+        chunk.state = State::Adding;
+      }
+
+      if (chunk.state != State::Adding)
+        continue;
+
+      // At least one entity is added each frame so that chunks are always added eventually
+      for (; chunk.added < chunk.data.entities.size(); ++chunk.added) {
+        if (added && commitBudget > steady_clock::duration::zero() && steady_clock::now() - start >= commitBudget)
+          return;
+        addEntity(chunk, chunk.added);
+        added = true;
+      }
+
+      chunk.data = {};
+      chunk.entities.clear();
+      chunk.entities.shrink_to_fit();
+      chunk.state = State::Loaded;
+    }
+  }
+
+  void WorldStreamer::unloadChunks(const glm::ivec2 center) {
+    for (auto it = chunks.begin(); it != chunks.end();) {
+      if (distance(coordinates(it->first), center) <= unloadRadius)
+        ++it;
+      else if (const State state = it->second.state;
+        unloadMode == UnloadMode::Deactivate && (state == State::Loaded || state == State::Inactive)) {
+        unload(it->second, false);
+        ++it;
+      } else {
+        unload(it->second, true);
+        it = chunks.erase(it);
+      }
+    }
+
+    if (maxLoadedChunks == 0 || chunks.size() <= maxLoadedChunks)
+      return;
+
+    // Over the memory budget, unload the chunks that are not needed, deactivated ones first and then the farthest
+    std::vector<std::tuple<bool, int, uint64_t>> candidates;
+    for (const auto &[chunk, data]: chunks)
+      if (const int d = distance(coordinates(chunk), center); d > loadRadius)
+        candidates.emplace_back(data.state != State::Inactive, -d, chunk);
+    std::ranges::sort(candidates);
+
+    for (const auto &[active, d, chunk]: candidates) {
+      if (chunks.size() <= maxLoadedChunks)
+        break;
+      unload(chunks.at(chunk), true);
+      chunks.erase(chunk);
+    }
+  }
+
+  void WorldStreamer::unload(Chunk &chunk, const bool evict) {
+    if (!evict) {
+      if (chunk.state != State::Loaded)
+        return;
+      for (const auto &root: chunk.roots)
+        if (root.valid())
+          root->SetActive(false);
+      chunk.state = State::Inactive;
+      return;
+    }
+
+    if (chunk.state == State::Loading) {
+      abandoned.emplace_back(std::move(chunk.loading));
+      return;
+    }
+
+    // Removing the roots destroys their children with them
+    for (const auto &root: chunk.roots)
+      if (root.valid() && !root->destroyed)
+        scene->removeEntity(root.get());
+    discard(chunk.data, chunk.added);
+  }
+
+  void WorldStreamer::addEntity(Chunk &chunk, const size_t index) {
+    auto &entity = chunk.data.entities[index];
+    const Engine::JSON &json = chunk.data.json.At(index).At("data");
+    const int parent = static_cast<int>(json.At("transform").At("data").At("parent").GetNumber());
+    const bool root = parent < 0 || parent >= static_cast<int>(chunk.entities.size());
+
+    entity->onDeserialize(Engine::Reflection::Format::JSON, json, scene, root ? nullptr : chunk.entities[parent]);
+    chunk.entities.emplace_back(entity.get());
+    if (root)
+      chunk.roots.emplace_back(entity.get());
+    scene->entitiesToAdd.emplace_back(std::move(entity));
+  }
+
+  std::string WorldStreamer::chunkPath(const std::string &directory, const glm::ivec2 chunk) {
+    return (std::filesystem::path(directory) / ("chunk_" + std::to_string(chunk.x) + "_" + std::to_string(chunk.y) +
+                                                ".json")).string();
+  }
+
+  WorldStreamer::ChunkData WorldStreamer::readChunk(const std::string &path, const uint32_t group) {
+    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerFunction);
+
+    // Chunks without any entity are not saved
+    ChunkData data;
+    std::ifstream file(path);
+    if (!file)
+      return data;
+
+    Engine::JSONParser parser(file);
+    Engine::JSON json = parser.Parse();
+    SceneResources().OnDeserialize(Engine::Reflection::Format::JSON, json.At("resources"));
+
+    data.json = std::move(json.At("entities"));
+    data.entities.reserve(data.json.Size());
+    for (const auto &entityJSON: data.json.GetArray()) {
+      auto entity = Engine::Reflection::Deserializer::FromJson<std::unique_ptr<Entity2D>>(entityJSON);
+      for (const auto &component: entity->allComponents)
+        if (const auto renderable = dynamic_cast<Rendering::Renderable2D *>(component.get()))
+          renderable->staticGroup = group;
+      data.entities.emplace_back(std::move(entity));
+    }
+    return data;
+  }
+
+  void WorldStreamer::discard(ChunkData &data, const size_t from) {
+    // The entities were never added to a scene, so there is nothing to remove their components from
+    for (size_t i = from; i < data.entities.size(); ++i)
+      if (data.entities[i])
+        data.entities[i]->free();
+    data = {};
+  }
+
+  uint64_t WorldStreamer::key(const glm::ivec2 chunk) {
+    return static_cast<uint64_t>(static_cast<uint32_t>(chunk.x)) << 32 | static_cast<uint32_t>(chunk.y);
+  }
+
+  glm::ivec2 WorldStreamer::coordinates(const uint64_t key) {
+    return {static_cast<int32_t>(static_cast<uint32_t>(key >> 32)), static_cast<int32_t>(static_cast<uint32_t>(key))};
+  }
+
+  int WorldStreamer::distance(const glm::ivec2 a, const glm::ivec2 b) {
+    return std::max(std::abs(a.x - b.x), std::abs(a.y - b.y));
+  }
+}
@@ -10,10 +10,10 @@
 #include "Engine2D/Transform2D.hpp"
 #include "Engine/Log.hpp"
 #include "Engine/Macros/Profiling.hpp"
+#include "Engine/Types/Pool.hpp"
 #include "Engine2D/Entity2D.hpp"
 #include "Engine2D/Game2D.hpp"
 #include "Engine2D/Rendering/Camera2D.hpp"
-#include "Engine2D/Rendering/SpriteRenderer.hpp"
 #include "Engine2D/SceneManagement/SceneManager.hpp"
 
 namespace Engine2D {
@@ -25,10 +25,19 @@ namespace Engine2D {
     const Engine::Ptr<Entity2D> &parent
   )
     : position(position), worldPosition(), rotation(rotation), worldRotation(0), scale(scale), worldScale(),
-      parent(parent), dirty(true), visible(true), projectionMatrix(glm::mat4(1.0f)) {
+      worldLinear(1.0f), parent(parent), worldDirty(false), version(1), visibility(0), previousWorldPosition(),
+      previousWorldRotation(0), previousPhysicsStep(0), hierarchyIndex(0), hierarchyEnd(0) {
     this->entity = entity;
   }
 
+  void *Transform2D::operator new(size_t) {
+    return Engine::Pool<Transform2D>::Allocate();
+  }
+
+  void Transform2D::operator delete(void *ptr) {
+    Engine::Pool<Transform2D>::Free(ptr);
+  }
+
   inline int index_of_ptr(const std::vector<std::unique_ptr<Entity2D>> &vec, const Entity2D *ptr) {
     if (!ptr)
       return -1;
@@ -106,7 +115,7 @@ namespace Engine2D {
       position = newPosition;
       rotation = fmod(newRotation, 360.0f);
       scale = newScale;
-      onTransformChange();
+      markDirty();
     }
   }
 
@@ -141,7 +150,7 @@ namespace Engine2D {
       position += positionIncrement;
       rotation = fmod(rotation + rotationIncrement, 360.0f);
       scale += scaleIncrement;
-      onTransformChange();
+      markDirty();
     }
   }
 
@@ -163,15 +172,21 @@ namespace Engine2D {
     if (this->parent)
       this->parent->transform->removeChild(Entity());
 
-    dirty = true;
     this->parent = parent;
     onParentHierarchyChange();
 
+    // The behaviours are dispatched and the transforms are propagated per hierarchy
+    if (Entity()->scene) {
+      Entity()->scene->dispatchListsDirty = true;
+      Entity()->scene->transformOrderDirty = true;
+    }
+
     // If no parent is specified, set the parent to null
     if (!parent) {
-      position = worldPosition;
-      rotation = worldRotation;
-      scale = worldScale;
+      const World current = world();
+      position = current.position;
+      rotation = current.rotation;
+      scale = current.scale;
       return;
     }
 
@@ -179,13 +194,11 @@ namespace Engine2D {
     this->parent->transform->addChild(Entity());
 
     // Convert the transform properties from world space to local space
-    const auto localTransform = glm::inverse(this->parent->transform->WorldMatrix()) * WorldMatrix();
-    position = glm::vec2(localTransform[3][0], localTransform[3][1]);
-    rotation = scale.x == 0
-                 ? 0
-                 : glm::degrees(std::atan2(localTransform[1][0] / scale.x, localTransform[0][0] / scale.x));
-    scale.x = glm::length(glm::vec2(localTransform[0][0], localTransform[1][0]));
-    scale.y = glm::length(glm::vec2(localTransform[0][1], localTransform[1][1]));
+    const auto [linear, translation] = this->parent->transform->WorldMatrix().Inverse() * WorldMatrix();
+    position = translation;
+    rotation = scale.x == 0 ? 0 : glm::degrees(std::atan2(linear[1][0] / scale.x, linear[0][0] / scale.x));
+    scale.x = glm::length(glm::vec2(linear[0][0], linear[1][0]));
+    scale.y = glm::length(glm::vec2(linear[0][1], linear[1][1]));
   }
 
   Engine::Ptr<Entity2D> Transform2D::Parent() const {
@@ -193,6 +206,18 @@ namespace Engine2D {
   }
 
   bool Transform2D::IsChildOf(const Engine::Ptr<Entity2D> &entity) const {
+    if (!entity)
+      return false;
+
+    // The descendants of a transform are stored right after it in the flattened hierarchies of the scene, which are
+    // up to date as long as no entity or hierarchy changed since they were built
+    const auto other = entity->Transform();
+    if (
+      const Scene *scene = this->entity ? this->entity->scene : nullptr;
+      scene && scene == entity->scene && !scene->transformOrderDirty && hierarchyEnd != 0 && other->hierarchyEnd != 0
+    )
+      return other->hierarchyIndex < hierarchyIndex && hierarchyIndex < other->hierarchyEnd;
+
     Engine::Ptr<Transform2D> current = parent ? parent->Transform() : nullptr;
 
     while (current) {
@@ -204,26 +229,36 @@ namespace Engine2D {
   }
 
   bool Transform2D::IsParentOf(const Engine::Ptr<Entity2D> &entity) const {
-    for (const auto &child: children)
-      if (child == entity)
-        return true;
-    return false;
+    return entity && entity->Transform()->parent == Entity();
   }
 
   glm::vec2 Transform2D::WorldPosition() const {
-    return worldPosition;
+    return world().position;
   }
 
   float Transform2D::WorldRotation() const {
-    return worldRotation;
+    return world().rotation;
+  }
+
+  glm::vec2 Transform2D::interpolatedWorldPosition(const float interpolation, const uint64_t physicsStep) const {
+    // Physics steps are counted from 1, 0 means that the transform was never moved by the physics engine
+    if (physicsStep == 0 || previousPhysicsStep != physicsStep)
+      return worldPosition;
+    return glm::mix(previousWorldPosition, worldPosition, interpolation);
+  }
+
+  float Transform2D::interpolatedWorldRotation(const float interpolation, const uint64_t physicsStep) const {
+    if (physicsStep == 0 || previousPhysicsStep != physicsStep)
+      return worldRotation;
+    return glm::mix(previousWorldRotation, worldRotation, interpolation);
   }
 
   glm::vec2 Transform2D::WorldScale() const {
-    return worldScale;
+    return world().scale;
   }
 
   glm::vec2 Transform2D::WorldHalfScale() const {
-    return worldScale * 0.5f;
+    return world().scale * 0.5f;
   }
 
   void Transform2D::RemoveAllChildren() {
@@ -238,6 +273,16 @@ namespace Engine2D {
   Engine::Ptr<Entity2D> Transform2D::Find(const std::string &name) const {
     ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerFunction);
 
+    // Only go through the entities of the scene that have this name instead of through all the children
+    if (const auto scene = entity ? entity->scene : Engine::Ptr<Scene>()) {
+      std::shared_lock lock(scene->namesMutex);
+      if (const auto it = scene->entitiesByName.find(name); it != scene->entitiesByName.end())
+        for (const auto candidate: it->second)
+          if (candidate && candidate->transform && candidate->transform->parent == entity && candidate->name == name)
+            return candidate;
+      return nullptr;
+    }
+
     for (const auto &child: children)
       if (child && child->name == name)
         return child;
@@ -301,27 +346,34 @@ namespace Engine2D {
   }
 
   bool Transform2D::IsVisible() {
-    if (dirty) {
-      visible = SceneManager::ActiveScene()->MainCamera() && SceneManager::ActiveScene()->MainCamera()->IsInViewport(worldPosition, worldScale);
-      dirty = false;
+    // The cached state is only refreshed once the world values are propagated
+    if (worldOutdated()) {
+      const auto camera = SceneManager::ActiveScene()->MainCamera();
+      const World current = world();
+      return camera && camera->IsInViewport(current.position, current.scale);
     }
+
+    const std::atomic_ref cache(visibility);
+    if (const uint64_t cached = cache.load(std::memory_order_relaxed); cached >> 1 == version)
+      return cached & 1;
+
+    const auto camera = SceneManager::ActiveScene()->MainCamera();
+    const bool visible = camera && camera->IsInViewport(worldPosition, worldScale);
+    cache.store(static_cast<uint64_t>(version) << 1 | visible, std::memory_order_relaxed);
     return visible;
   }
 
-  const glm::mat4 &Transform2D::WorldMatrix() {
-    ENGINE_PROFILE_FUNCTION(ProfilingLevel::PerSubSystem);
-    if (dirty) {
-      projectionMatrix =
-          glm::translate(glm::mat4(1.0f), glm::vec3(worldPosition, 0.0f)) *
-          glm::rotate(glm::mat4(1.0f), worldRotation, glm::vec3(0.0f, 0.0f, 1.0f)) *
-          glm::scale(glm::mat4(1.0f), glm::vec3(worldScale, 1.0f));
-      dirty = false;
-    }
-    return projectionMatrix;
+  uint32_t Transform2D::Version() const {
+    return version;
+  }
+
+  Affine2D Transform2D::WorldMatrix() const {
+    const World current = world();
+    return {current.linear, current.position};
   }
 
-  glm::vec2 Transform2D::WorldToLocal(const glm::vec2 &point) {
-    return glm::vec2(glm::vec2(glm::inverse(WorldMatrix()) * glm::vec4(point, 0.0f, 1.0f)));
+  glm::vec2 Transform2D::WorldToLocal(const glm::vec2 &point) const {
+    return WorldMatrix().Inverse().TransformPoint(point);
   }
 
   const std::vector<Engine::Ptr<Entity2D>> &Transform2D::Children() const {
@@ -329,55 +381,94 @@ namespace Engine2D {
   }
 
   void Transform2D::onTransformChange() {
-    const auto oldWorldPosition = worldPosition;
-    const auto oldWorldRotation = worldRotation;
-    const auto oldWorldScale = worldScale;
-
-    worldPosition = position;
-    worldRotation = rotation;
-    worldScale = scale;
-
-    Engine::Ptr<Transform2D> current = parent ? parent->Transform() : nullptr;
-    while (current) {
-      worldPosition = glm::rotate(worldPosition * current->scale, -glm::radians(current->rotation)) + current->position;
-      worldRotation += current->rotation;
-      worldScale = worldScale * current->scale;
-      current = current->parent ? current->parent->Transform() : nullptr;
-    }
-
-    if (oldWorldPosition == worldPosition && oldWorldRotation == worldRotation && oldWorldScale == worldScale)
+    const bool changed = applyWorld(composeWorld(parent ? parent->transform->world() : World{}));
+    if (!changed)
       return;
 
-    // Determine if the sprite is currently visible to the camera
-    worldRotation = -glm::radians(worldRotation);
-    dirty = true;
-
-    if (const auto renderer = Entity()->GetComponent<Rendering::SpriteRenderer>())
-      renderer->dirty = true;
-
     // Update the children of this transform as they depend on the transform of their parent
     for (const auto &child: children)
       if (child)
         child->transform->onTransformChange();
   }
 
-  void Transform2D::onParentHierarchyChange() const {
-    // Check if the entity has a parent
-    if (!parent) {
-      Entity()->parentsActive = true;
+  void Transform2D::markDirty() {
+    // Entities that are not in a scene yet are not part of any propagation pass
+    if (!entity || !entity->initialized || !entity->scene) {
+      onTransformChange();
       return;
     }
 
+    worldDirty = true;
+    entity->scene->transformsDirty = true;
+  }
+
+  bool Transform2D::worldOutdated() const {
+    // Most of the time no transform waits for a propagation pass, which saves walking up the hierarchy
+    if (!entity || !entity->scene || !entity->scene->transformsDirty)
+      return false;
+
+    for (const Transform2D *current = this; current;) {
+      if (current->worldDirty)
+        return true;
+      current = current->parent ? current->parent->transform.get() : nullptr;
+    }
+    return false;
+  }
+
+  Transform2D::World Transform2D::world() const {
+    if (!worldOutdated())
+      return {worldPosition, worldRotation, worldScale, worldLinear};
+    return composeWorld(parent ? parent->transform->world() : World{});
+  }
+
+  Transform2D::World Transform2D::composeWorld(const World &parentWorld) const {
+    // Local rotations are clockwise in degrees, world rotations are counterclockwise in radians
+    const float radians = -glm::radians(rotation);
+    const auto [linear, translation] =
+        Affine2D(parentWorld.linear, parentWorld.position) * Affine2D::TRS(position, radians, scale);
+
+    World result;
+    result.position = translation;
+    result.rotation = parentWorld.rotation + radians;
+    result.scale = parentWorld.scale * scale;
+    result.linear = linear;
+    return result;
+  }
+
+  bool Transform2D::applyWorld(const World &values) {
+    worldDirty = false;
+    if (
+      values.position == worldPosition && values.rotation == worldRotation && values.scale == worldScale &&
+      values.linear == worldLinear
+    )
+      return false;
+
+    worldPosition = values.position;
+    worldRotation = values.rotation;
+    worldScale = values.scale;
+    worldLinear = values.linear;
+    // 0 is kept for the versions that were never recorded
+    if (++version == 0)
+      version = 1;
+    return true;
+  }
+
+  void Transform2D::onParentHierarchyChange() const {
     // If it is active, make sure all it's parents are also active
+    bool parentsActive = true;
     Engine::Ptr<Transform2D> current = parent != nullptr ? parent->Transform() : nullptr;
     while (current && current->Entity()) {
       if (!current->Entity()->active) {
-        Entity()->parentsActive = false;
-        return;
+        parentsActive = false;
+        break;
       }
       current = current->parent ? current->parent->Transform() : nullptr;
     }
-    Entity()->parentsActive = true;
+
+    // The behaviours of entities whose parents were activated are added to the dispatch
+    if (!Entity()->parentsActive && parentsActive && Entity()->scene)
+      Entity()->scene->queueActivation(Entity().get());
+    Entity()->parentsActive = parentsActive;
   }
 
   void Transform2D::addChild(const Engine::Ptr<Entity2D> &child) {